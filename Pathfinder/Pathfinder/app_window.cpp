@@ -10,9 +10,11 @@
 #include "app_window.h"
 #include "app_graphics.h"
 #include "map_grid.h"
+#include "search_scheduler.h"
 #include <GL/gl3w.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <cmath>
 
 #define APP_GL_VER_MAJOR 3
 #define APP_GL_VER_MINOR 3
@@ -24,6 +26,11 @@ const float DRAW_FRAME_OFFSET = APP_WINDOW_SIZE * 0.05f;
 const float GRID_CELL_SIZE = (APP_WINDOW_SIZE - 2.0f * DRAW_FRAME_OFFSET) / GRID_SIZE;
 
 MapGrid newMap(GRID_SIZE, GRID_SIZE);  // create 10x10 square map grid
+// searches run a slice per frame, so large maps do not block the window
+SearchScheduler pathSearches(newMap);
+int pathTicket = SearchScheduler::NO_TICKET;
+const std::chrono::microseconds PATH_FRAME_BUDGET(2000);
+std::vector<MapGrid::GridPos> gridPath;
 float gridVertiColor[GRID_SIZE * GRID_SIZE * 24];
 unsigned int gridIndices[GRID_SIZE * GRID_SIZE * 6];
 std::vector<float> pathVertices;
@@ -93,6 +100,8 @@ GLuint pathEBO;
 
 static void GenerateDrawBuffers(void);
 static void UpdateGridVertices(void);
+static void RequestPath(void);
+static void UpdateFinishedPath(void);
 static void glfw_error_callback(int error, const char* description);
 static void glfw_mouse_btn_callback(GLFWwindow* window, int button, int action, int mods);
 
@@ -130,7 +139,10 @@ void Start_AppWindow(void)
 	std::cout << "GL Version: " << glGetString(GL_VERSION) << std::endl;
 	std::cout << "Shader Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
 
-	UpdateGridVertices();
+	// the first path is waited for, the draw buffers are sized by it
+	RequestPath();
+	while (pathSearches.GetRunningCount()) pathSearches.RunFrame(PATH_FRAME_BUDGET);
+	UpdateFinishedPath();
 
 	GenerateDrawBuffers();
 	CompileShader(GRID_VS_SRC, &gridVS, GL_VERTEX_SHADER);
@@ -148,6 +160,9 @@ void Start_AppWindow(void)
 		glClearColor(0, 0, 0, 1);
 		glClear(GL_COLOR_BUFFER_BIT);
 
+		pathSearches.RunFrame(PATH_FRAME_BUDGET);
+		UpdateFinishedPath();
+
 		//Draw Here!
 		glUseProgram(gridShaderPrg);
 		glBindVertexArray(gridVAO);
@@ -217,24 +232,42 @@ static void GenerateDrawBuffers(void)
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, pathIndices.size() * sizeof(unsigned int), &pathIndices[0], GL_DYNAMIC_DRAW);
 }
 
+// starts a search between the start and target of the map, the last one is dropped
+static void RequestPath(void)
+{
+	pathSearches.Release(pathTicket);
+	pathTicket = pathSearches.Submit(newMap.GetStartPos(), newMap.GetTargetPos());
+}
+
+// draws the path of the search once it has finished
+static void UpdateFinishedPath(void)
+{
+	if (pathTicket == SearchScheduler::NO_TICKET || pathSearches.GetStatus(pathTicket) == MapGrid::SearchStatus::Running) return;
+	pathSearches.GetPath(pathTicket, gridPath);
+	UpdateGridVertices();
+	pathSearches.Release(pathTicket);
+	pathTicket = SearchScheduler::NO_TICKET;
+}
+
 static void UpdateGridVertices(void)
 {
-	auto path = newMap.Find_AStar_Path();
-	MapGrid::Node* mapGrid = newMap.GetGridArray();
-	const MapGrid::Node* startNode = newMap.GetStartNode();
-	const MapGrid::Node* targetNode = newMap.GetTargetNode();
+	const std::vector<MapGrid::GridPos>& path = gridPath;
+	const MapGrid::GridView mapGrid = newMap.GetGridView();
+	// visited cells of the search that is being drawn
+	const SearchContext<MapGrid::Cost>* search = (pathTicket != SearchScheduler::NO_TICKET) ? &pathSearches.GetContext(pathTicket) : nullptr;
 	// update grid draw vertices and colors
 	for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++)
 	{
-		float centerX = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * mapGrid[i].x + (GRID_CELL_SIZE / 2.0f);
-		float centerY = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * mapGrid[i].y + (GRID_CELL_SIZE / 2.0f);
+		MapGrid::GridPos cellPos = mapGrid.GetCellPos(i);
+		float centerX = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * cellPos.first + (GRID_CELL_SIZE / 2.0f);
+		float centerY = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * cellPos.second + (GRID_CELL_SIZE / 2.0f);
 		int vtxIdx = 0;
 		int indiceIdx = 0;
 		const float* cellColor = COLOR_EMPTY;
-		if (&mapGrid[i] == startNode) cellColor = COLOR_START;
-		else if (&mapGrid[i] == targetNode) cellColor = COLOR_TARGET;
-		else if (mapGrid[i].isObstacle) cellColor = COLOR_OBSTACLE;
-		else if (mapGrid[i].isVisited) cellColor = COLOR_VISITED;
+		if (mapGrid.IsStart(i)) cellColor = COLOR_START;
+		else if (mapGrid.IsTarget(i)) cellColor = COLOR_TARGET;
+		else if (mapGrid.IsObstacle(i)) cellColor = COLOR_OBSTACLE;
+		else if (search && search->IsCellVisited(i)) cellColor = COLOR_VISITED;
 
 		gridVertiColor[i * 24 + vtxIdx++] = centerX + (GRID_CELL_SIZE / 2.0f) * 0.8f; // x0
 		gridVertiColor[i * 24 + vtxIdx++] = centerY + (GRID_CELL_SIZE / 2.0f) * 0.8f; // y0
@@ -279,10 +312,10 @@ static void UpdateGridVertices(void)
 	{
 		for (int i = 0; i < path.size() - 1; i++)
 		{
-			float centerX = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i]->x + (GRID_CELL_SIZE / 2.0f);
-			float centerY = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i]->y + (GRID_CELL_SIZE / 2.0f);
-			float centerX_1 = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i + 1]->x + (GRID_CELL_SIZE / 2.0f);
-			float centerY_1 = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i + 1]->y + (GRID_CELL_SIZE / 2.0f);
+			float centerX = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i].first + (GRID_CELL_SIZE / 2.0f);
+			float centerY = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i].second + (GRID_CELL_SIZE / 2.0f);
+			float centerX_1 = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i + 1].first + (GRID_CELL_SIZE / 2.0f);
+			float centerY_1 = DRAW_FRAME_OFFSET + GRID_CELL_SIZE * path[i + 1].second + (GRID_CELL_SIZE / 2.0f);
 			float vX = centerX_1 - centerX;
 			float vY = centerY_1 - centerY;
 			float vR = sqrtf(vX * vX + vY * vY);
@@ -341,15 +374,15 @@ static void glfw_mouse_btn_callback(GLFWwindow* window, int button, int action,
 
 		if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS) {
 			newMap.ToggleObstacle(MapGrid::GridPos(cellX, cellY));
-			UpdateGridVertices();
+			RequestPath();
 		}
 		if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
 			newMap.SetStartPos(MapGrid::GridPos(cellX, cellY));
-			UpdateGridVertices();
+			RequestPath();
 		}
 		if (button == GLFW_MOUSE_BUTTON_MIDDLE && action == GLFW_PRESS) {
 			newMap.SetTargetPos(MapGrid::GridPos(cellX, cellY));
-			UpdateGridVertices();
+			RequestPath();
 		}
 	}
 }
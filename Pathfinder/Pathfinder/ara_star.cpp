@@ -0,0 +1,223 @@
+/**
+  ******************************************************************************
+  * @file    ara_star.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the implementation of the ARA* planner.
+  ******************************************************************************
+  */
+#include "ara_star.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const uint32_t AraStar::WEIGHT_ONE;
+const uint32_t AraStar::NO_PARENT;
+
+AraStar::AraStar(const MapGrid& map) : _Map(map), _Obstacles(map.GetObstacleBitmap())
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	size_t cellCount = (size_t)size.first * size.second;
+	_SizeX = size.first;
+	_NeighbourCount = map.GetNeighbourCount();
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		_DirX[dir] = offset.first;
+		_DirY[dir] = offset.second;
+		_StepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	_G.resize(cellCount);
+	_Parent.resize(cellCount);
+	_QueryIds.assign(cellCount, 0);
+	_PassIds.assign(cellCount, 0);
+	_Open.Resize(cellCount);
+	_Bound = std::numeric_limits<double>::infinity();
+}
+
+void AraStar::SetWeights(double initialWeight, double weightStep)
+{
+	_InitialWeight = (uint32_t)std::lround(std::max(initialWeight, 1.0) * WEIGHT_ONE);
+	// a step below the fixed point resolution would never reach a weight of 1
+	_WeightStep = std::max((uint32_t)std::lround(std::max(weightStep, 0.0) * WEIGHT_ONE), 1u);
+}
+
+bool AraStar::Plan(GridPos startPos, GridPos targetPos, std::chrono::microseconds budget)
+{
+	Clock::time_point deadline = Clock::now() + budget;
+	_HasQuery = false;
+	_Optimal = false;
+	_Path.clear();
+	_PathCost = MapGrid::COST_INFINITY;
+	_Bound = std::numeric_limits<double>::infinity();
+	_ExpandedNodeCount = 0;
+	if (_Obstacles.Test(startPos.first, startPos.second) || _Obstacles.Test(targetPos.first, targetPos.second)) return false;
+	if (!_Map.AreConnected(startPos, targetPos)) return false;
+
+	_QueryId++;
+	if (_QueryId == 0) {
+		// counter wrapped around, old ids could be mistaken for the current query
+		std::fill(_QueryIds.begin(), _QueryIds.end(), 0);
+		_QueryId = 1;
+	}
+	_PassId++;
+	if (_PassId == 0) {
+		std::fill(_PassIds.begin(), _PassIds.end(), 0);
+		_PassId = 1;
+	}
+	_Open.Clear();
+	_Inconsistent.clear();
+	_Start = startPos.second * _SizeX + startPos.first;
+	_Target = targetPos.second * _SizeX + targetPos.first;
+	_Weight = _InitialWeight;
+	TouchCell(_Start);
+	_G[_Start] = 0;
+	_Open.Push(_Start, Key(_Start));
+	_HasQuery = true;
+	return Run(deadline);
+}
+
+bool AraStar::Improve(std::chrono::microseconds budget)
+{
+	if (!_HasQuery) return false;
+	return Run(Clock::now() + budget);
+}
+
+bool AraStar::Run(Clock::time_point deadline)
+{
+	while (!_Optimal) {
+		if (!ImprovePath(deadline)) break;
+		if (GetG(_Target) == MapGrid::COST_INFINITY) {
+			// the open list ran dry, the map labels were not there to tell the cells apart
+			_HasQuery = false;
+			break;
+		}
+		StorePath();
+
+		// cells still to expand bound the shortest path from below, the pass weight bounds
+		// the path from above
+		double passWeight = (double)_Weight / WEIGHT_ONE;
+		bool lastPass = _Weight == WEIGHT_ONE;
+		uint64_t lowest = NextPass();
+		if (lastPass || lowest >= _PathCost) {
+			_Bound = 1.0;
+			_Optimal = true;
+		}
+		else {
+			_Bound = std::max(1.0, std::min(passWeight, (double)_PathCost / (double)lowest));
+		}
+	}
+	return !_Path.empty();
+}
+
+void AraStar::GetPath(std::vector<GridPos>& path) const
+{
+	path.clear();
+	for (uint32_t cell : _Path) path.push_back(GridPos(cell % _SizeX, cell / _SizeX));
+}
+
+MapGrid::Cost AraStar::GetPathCost(void) const
+{
+	return _PathCost;
+}
+
+double AraStar::GetSuboptimalityBound(void) const
+{
+	return _Bound;
+}
+
+bool AraStar::IsExhausted(void) const
+{
+	return !_HasQuery || _Optimal;
+}
+
+void AraStar::TouchCell(uint32_t cell)
+{
+	if (_QueryIds[cell] != _QueryId) {
+		_QueryIds[cell] = _QueryId;
+		_G[cell] = MapGrid::COST_INFINITY;
+		_Parent[cell] = NO_PARENT;
+	}
+}
+
+uint64_t AraStar::Key(uint32_t cell) const
+{
+	return (uint64_t)_G[cell] * WEIGHT_ONE + (uint64_t)_Weight * Heuristic(cell, _Target);
+}
+
+uint64_t AraStar::NextPass(void)
+{
+	_Weight = (_Weight > WEIGHT_ONE + _WeightStep) ? _Weight - _WeightStep : WEIGHT_ONE;
+	_PassId++;
+	if (_PassId == 0) {
+		std::fill(_PassIds.begin(), _PassIds.end(), 0);
+		_PassId = 1;
+	}
+
+	// the open list is re-keyed for the new weight and the inconsistent cells join it
+	uint64_t lowest = std::numeric_limits<uint64_t>::max();
+	_Open.Rekey([this, &lowest](uint32_t cell) {
+		lowest = std::min(lowest, (uint64_t)_G[cell] + Heuristic(cell, _Target));
+		return Key(cell);
+	});
+	for (uint32_t cell : _Inconsistent) {
+		// a cell made cheaper more than once is listed more than once, the key is the same
+		lowest = std::min(lowest, (uint64_t)_G[cell] + Heuristic(cell, _Target));
+		_Open.PushOrDecrease(cell, Key(cell));
+	}
+	_Inconsistent.clear();
+	return lowest;
+}
+
+bool AraStar::ImprovePath(Clock::time_point deadline)
+{
+	int sinceClockCheck = 0;
+	while (!_Open.Empty() && (uint64_t)GetG(_Target) * WEIGHT_ONE > _Open.TopKey()) {
+		if (++sinceClockCheck == EXPANSIONS_PER_CLOCK_CHECK) {
+			sinceClockCheck = 0;
+			if (Clock::now() >= deadline) return false;
+		}
+		uint32_t current = _Open.Pop();
+		_PassIds[current] = _PassId;
+		_ExpandedNodeCount++;
+
+		int cx = current % _SizeX;
+		int cy = current / _SizeX;
+		for (int dir = 0; dir < _NeighbourCount; dir++) {
+			if (!_Map.IsMoveAllowed(cx, cy, _DirX[dir], _DirY[dir])) continue;
+			uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+			TouchCell(neighbour);
+			Cost localGoal = _G[current] + _StepCost[dir];
+			if (localGoal >= _G[neighbour]) continue;
+			_G[neighbour] = localGoal;
+			_Parent[neighbour] = current;
+			// cells expanded in this pass are not expanded again until the next one
+			if (_PassIds[neighbour] == _PassId) _Inconsistent.push_back(neighbour);
+			else _Open.PushOrDecrease(neighbour, Key(neighbour));
+		}
+	}
+	return true;
+}
+
+void AraStar::StorePath(void)
+{
+	// later passes rewire the parents, the path is copied so it stays the one reported
+	_Path.clear();
+	_PathCost = 0;
+	for (uint32_t cell = _Target; cell != NO_PARENT; cell = _Parent[cell]) {
+		uint32_t parent = _Parent[cell];
+		if (parent != NO_PARENT) {
+			bool diagonal = (cell % _SizeX) != (parent % _SizeX) && (cell / _SizeX) != (parent / _SizeX);
+			_PathCost += diagonal ? MapGrid::COST_DIAGONAL : MapGrid::COST_STRAIGHT;
+		}
+		_Path.push_back(cell);
+	}
+	std::reverse(_Path.begin(), _Path.end());
+}
+
+MapGrid::Cost AraStar::Heuristic(uint32_t a, uint32_t b) const
+{
+	int dx = (int)(a % _SizeX) - (int)(b % _SizeX);
+	int dy = (int)(a / _SizeX) - (int)(b / _SizeX);
+	if (_NeighbourCount == 4) return ManhattanCost<Cost>(dx, dy);
+	return OctileCost<Cost>(dx, dy);
+}
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    ara_star.h
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the declaration of the anytime repairing A*
+  *          (ARA*) planner. A weighted A* with an inflated heuristic finds a
+  *          first path quickly, then the weight is lowered step by step and the
+  *          search continues from its open list instead of starting over. Cells
+  *          that get cheaper after they were expanded in the current pass wait
+  *          in an inconsistent list and rejoin the open list in the next pass.
+  *          Every query runs until its time budget runs out or the path is
+  *          proven shortest, and reports how far the path can be from optimal.
+  ******************************************************************************
+  */
+
+#ifndef ARA_STAR_H
+#define ARA_STAR_H
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include "map_grid.h"
+#include "indexed_heap.h"
+
+class AraStar {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::Cost Cost;
+	typedef std::chrono::steady_clock Clock;
+
+	// the planner keeps a reference to the map, it must outlive the planner
+	AraStar(const MapGrid& map);
+	// weights multiply the heuristic, the first pass uses initialWeight and every pass lowers it by
+	// weightStep until it reaches 1
+	void SetWeights(double initialWeight, double weightStep);
+
+	// starts a new query and improves it until the budget runs out. True if a path is available,
+	// a budget too short for the first pass can be continued with Improve
+	bool Plan(GridPos start, GridPos target, std::chrono::microseconds budget);
+	// continues the last query with a new budget, the map must not have changed since Plan
+	bool Improve(std::chrono::microseconds budget);
+
+	void GetPath(std::vector<GridPos>& path) const; // best path so far, start first, reuses the vector's storage
+	Cost GetPathCost(void) const; // cost of the best path so far or COST_INFINITY
+	// the best path costs at most this many times the shortest one, infinity without a path
+	double GetSuboptimalityBound(void) const;
+	bool IsOptimal(void) const { return _Optimal; }
+	bool IsExhausted(void) const; // nothing left to improve, the path is shortest or there is none
+	int GetExpandedNodeCount(void) const { return _ExpandedNodeCount; } // all passes of the last query
+
+private:
+	// weights are fixed point, WEIGHT_ONE is a weight of 1
+	static const uint32_t WEIGHT_ONE = 1000;
+	static const uint32_t NO_PARENT = 0xFFFFFFFFu;
+	static const int EXPANSIONS_PER_CLOCK_CHECK = 64;
+
+	const MapGrid& _Map;
+	const ObstacleBitmap& _Obstacles;
+	int _SizeX = 0;
+	int _DirX[8];
+	int _DirY[8];
+	Cost _StepCost[8];
+	int _NeighbourCount = 4;
+	uint32_t _InitialWeight = 2500;
+	uint32_t _WeightStep = 500;
+
+	std::vector<Cost> _G; // cost from the start
+	std::vector<uint32_t> _Parent;
+	std::vector<unsigned int> _QueryIds; // query that last touched the cell, older values mean stale data
+	std::vector<unsigned int> _PassIds; // pass that expanded the cell or put it on the inconsistent list
+	unsigned int _QueryId = 0;
+	unsigned int _PassId = 0;
+	IndexedHeap<uint64_t> _Open; // keyed by g * WEIGHT_ONE + weight * h
+	std::vector<uint32_t> _Inconsistent; // expanded in this pass and made cheaper afterwards
+
+	uint32_t _Start = 0;
+	uint32_t _Target = 0;
+	uint32_t _Weight = 0; // weight of the current pass
+	bool _HasQuery = false;
+	bool _Optimal = false;
+	std::vector<uint32_t> _Path; // cells of the best path, start first
+	Cost _PathCost = MapGrid::COST_INFINITY;
+	double _Bound = 0.0;
+	int _ExpandedNodeCount = 0;
+
+	void TouchCell(uint32_t cell);
+	Cost GetG(uint32_t cell) const { return _QueryIds[cell] == _QueryId ? _G[cell] : MapGrid::COST_INFINITY; }
+	uint64_t Key(uint32_t cell) const;
+	Cost Heuristic(uint32_t a, uint32_t b) const;
+	uint64_t NextPass(void); // lowers the weight, returns the lowest g + h of the cells left to expand
+	bool Run(Clock::time_point deadline); // passes until the deadline, true if a path is available
+	bool ImprovePath(Clock::time_point deadline); // false if the deadline ran out first
+	void StorePath(void);
+};
+
+#endif
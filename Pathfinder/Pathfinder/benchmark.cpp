@@ -0,0 +1,773 @@
+/**
+  ******************************************************************************
+  * @file    benchmark.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the pathfinding benchmark.
+  *          Every scenario is generated deterministically so the numbers can be
+  *          compared between different versions of the search.
+  ******************************************************************************
+  */
+#include "benchmark.h"
+#include "map_grid.h"
+#include "parallel_for.h"
+#include "path_batch.h"
+#include "dstar_lite.h"
+#include "reverse_tree.h"
+#include "flow_field.h"
+#include "hpa_star.h"
+#include "path_database.h"
+#include "bidirectional_search.h"
+#include "ara_star.h"
+#include "search_scheduler.h"
+#include "theta_star.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock BenchClock;
+
+struct BenchEngine {
+	const char* name;
+	MapGrid::Connectivity connectivity; // grid connectivity the engine is measured on
+	std::function<std::vector<MapGrid::GridPos>(MapGrid&, int& expanded)> query;
+	std::function<void(MapGrid&)> prepare; // untimed preprocessing, may be empty
+};
+
+enum class Scenario {
+	Open,   // no obstacles, start and target on opposite corners
+	Maze,   // perfect maze carved with a randomized depth first search
+	NoPath, // target is walled off by a full column of obstacles
+	Short   // no obstacles, target a few cells away from the start
+};
+
+static const char* ScenarioName(Scenario scenario)
+{
+	switch (scenario) {
+	case Scenario::Open: return "open";
+	case Scenario::Maze: return "maze";
+	case Scenario::NoPath: return "no-path";
+	case Scenario::Short: return "short";
+	}
+	return "";
+}
+
+static void CarveMaze(MapGrid& map, int sizeX, int sizeY)
+{
+	// maze rooms are on even coordinates, everything else starts as wall
+	for (int y = 0; y < sizeY; y++) {
+		for (int x = 0; x < sizeX; x++) {
+			if ((x % 2) || (y % 2)) map.ToggleObstacle(MapGrid::GridPos(x, y));
+		}
+	}
+
+	const int dirs[4][2] = { { 2, 0 }, { -2, 0 }, { 0, 2 }, { 0, -2 } };
+	std::mt19937 rng(1); // fixed seed, same maze on every run
+	std::vector<bool> carved(sizeX * sizeY, false);
+	std::vector<int> stack;
+	stack.push_back(0);
+	carved[0] = true;
+	while (!stack.empty()) {
+		int cx = stack.back() % sizeX;
+		int cy = stack.back() / sizeX;
+		int options[4];
+		int optionCount = 0;
+		for (int i = 0; i < 4; i++) {
+			int nx = cx + dirs[i][0];
+			int ny = cy + dirs[i][1];
+			if (nx >= 0 && ny >= 0 && nx < sizeX - 1 && ny < sizeY - 1 && !carved[ny * sizeX + nx]) {
+				options[optionCount++] = i;
+			}
+		}
+		if (optionCount == 0) {
+			stack.pop_back();
+			continue;
+		}
+		int dir = options[rng() % optionCount];
+		int nx = cx + dirs[dir][0];
+		int ny = cy + dirs[dir][1];
+		map.ToggleObstacle(MapGrid::GridPos(cx + dirs[dir][0] / 2, cy + dirs[dir][1] / 2));
+		carved[ny * sizeX + nx] = true;
+		stack.push_back(ny * sizeX + nx);
+	}
+}
+
+static void BuildScenario(MapGrid& map, Scenario scenario)
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	map.SetStartPos(MapGrid::GridPos(0, 0));
+	map.SetTargetPos(MapGrid::GridPos(size.first - 1, size.second - 1));
+
+	if (scenario == Scenario::Maze) {
+		CarveMaze(map, size.first, size.second);
+		map.SetTargetPos(MapGrid::GridPos(size.first - 2, size.second - 2)); // last room of the maze
+	}
+	else if (scenario == Scenario::NoPath) {
+		for (int y = 0; y < size.second; y++) {
+			map.ToggleObstacle(MapGrid::GridPos(size.first / 2, y));
+		}
+	}
+	else if (scenario == Scenario::Short) {
+		map.SetStartPos(MapGrid::GridPos(size.first / 2, size.second / 2));
+		map.SetTargetPos(MapGrid::GridPos(size.first / 2 + 5, size.second / 2));
+	}
+}
+
+static float PathCost(const std::vector<MapGrid::GridPos>& path)
+{
+	float cost = 0.0f;
+	for (size_t i = 1; i < path.size(); i++) {
+		float dx = (float)(path[i].first - path[i - 1].first);
+		float dy = (float)(path[i].second - path[i - 1].second);
+		cost += sqrtf(dx * dx + dy * dy);
+	}
+	return cost;
+}
+
+static void PrintResult(const std::string& engine, Scenario scenario, int expanded, const std::vector<MapGrid::GridPos>& path, double ms)
+{
+	double rate = ms > 0.0 ? expanded / (ms / 1000.0) : 0.0;
+	std::cout << std::left << std::setw(10) << engine
+		<< std::setw(10) << ScenarioName(scenario)
+		<< std::right << std::setw(12) << expanded
+		<< std::setw(10) << path.size()
+		<< std::setw(12) << std::fixed << std::setprecision(2) << PathCost(path)
+		<< std::setw(12) << std::setprecision(4) << ms
+		<< std::setw(16) << std::setprecision(0) << rate << std::endl;
+}
+
+static double ElapsedMs(BenchClock::time_point begin)
+{
+	return std::chrono::duration<double, std::milli>(BenchClock::now() - begin).count();
+}
+
+static void Run_PreprocessingBenchmark(int gridSize)
+{
+	MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+	BuildScenario(map, Scenario::Maze);
+	std::cout << std::endl << "preprocessing on the maze scenario" << std::endl;
+
+	const int threadCounts[] = { 1, 0 };
+	for (int threads : threadCounts) {
+		BenchClock::time_point begin = BenchClock::now();
+		map.BuildJpsPlusTable(threads);
+		std::cout << "jps+ table build, " << (threads ? "1 thread" : "all cores") << ": "
+			<< std::setprecision(3) << ElapsedMs(begin) << " ms" << std::endl;
+	}
+
+	BenchClock::time_point begin = BenchClock::now();
+	const int toggles = 100;
+	for (int i = 0; i < toggles; i++) {
+		map.ToggleObstacle(MapGrid::GridPos((i * 37) % gridSize, (i * 91) % gridSize));
+	}
+	std::cout << "jps+ repair per ToggleObstacle: " << std::setprecision(3) << ElapsedMs(begin) / toggles << " ms" << std::endl;
+
+	begin = BenchClock::now();
+	map.BuildComponentLabels();
+	std::cout << "component label sweep: " << std::setprecision(3) << ElapsedMs(begin) << " ms" << std::endl;
+	begin = BenchClock::now();
+	for (int i = 0; i < toggles; i++) {
+		map.ToggleObstacle(MapGrid::GridPos((i * 53) % gridSize, (i * 29) % gridSize));
+	}
+	std::cout << "jps+ and component update per ToggleObstacle: " << std::setprecision(3) << ElapsedMs(begin) / toggles << " ms" << std::endl;
+}
+
+// short random queries between maze rooms, a room is a free cell on even coordinates
+static std::vector<PathQuery> MakeMazeQueries(int gridSize, int count, int range)
+{
+	std::mt19937 rng(2);
+	int rooms = gridSize / 2;
+	std::vector<PathQuery> queries(count);
+	for (PathQuery& query : queries) {
+		int sx = rng() % rooms;
+		int sy = rng() % rooms;
+		int tx = std::min(rooms - 1, std::max(0, sx + (int)(rng() % (2 * range + 1)) - range));
+		int ty = std::min(rooms - 1, std::max(0, sy + (int)(rng() % (2 * range + 1)) - range));
+		query.start = MapGrid::GridPos(sx * 2, sy * 2);
+		query.target = MapGrid::GridPos(tx * 2, ty * 2);
+	}
+	return queries;
+}
+
+static void Run_BatchBenchmark(int gridSize)
+{
+	MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+	BuildScenario(map, Scenario::Maze);
+	std::vector<PathQuery> queries = MakeMazeQueries(gridSize, 1000, 8);
+	std::cout << std::endl << "batch queries on the maze scenario, one map shared by all threads, "
+		<< queries.size() << " jps queries" << std::endl;
+
+	double singleThreadRate = 0.0;
+	int maxThreads = DefaultThreadCount();
+	for (int threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+		PathBatch batch(map, MapGrid::Algorithm::JPS, threads);
+		batch.FindPaths(queries); // first batch sizes the contexts and the path buffers
+		BenchClock::time_point begin = BenchClock::now();
+		batch.FindPaths(queries);
+		double rate = queries.size() / (ElapsedMs(begin) / 1000.0);
+		if (threads == 1) singleThreadRate = rate;
+		std::cout << std::setw(3) << threads << " threads: " << std::setprecision(0) << rate << " queries/s, speedup "
+			<< std::setprecision(2) << rate / singleThreadRate << std::endl;
+		if (threads == maxThreads) break;
+	}
+}
+
+// a robot walks along its path and a sensor blocks a cell a few steps ahead of it after every move
+static void Run_ReplanningBenchmark(int gridSize)
+{
+	MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+	std::mt19937 rng(3);
+	for (int i = 0; i < gridSize * gridSize / 4; i++) {
+		map.ToggleObstacle(MapGrid::GridPos(rng() % gridSize, rng() % gridSize));
+	}
+	MapGrid::GridPos start(gridSize / 8, gridSize / 8);
+	MapGrid::GridPos target(gridSize * 7 / 8, gridSize * 7 / 8);
+	map.SetStartPos(start);
+	map.SetTargetPos(target);
+	std::cout << std::endl << "replanning on a random obstacle map, a cell ahead of the start is blocked before every plan" << std::endl;
+
+	DStarLite planner(map);
+	BenchClock::time_point begin = BenchClock::now();
+	planner.Plan(start, target);
+	std::cout << "d* lite first plan: " << std::setprecision(3) << ElapsedMs(begin) << " ms, "
+		<< planner.GetExpandedNodeCount() << " expanded" << std::endl;
+
+	// a detour around a bottleneck repairs much of the tree, so the median is printed next to the mean
+	const int steps = 50;
+	std::vector<double> replanMs;
+	std::vector<double> searchMs;
+	std::vector<MapGrid::GridPos> path;
+	for (int i = 0; i < steps; i++) {
+		planner.GetPath(path);
+		if (path.size() < 12) break;
+		start = path[1];
+		map.ToggleObstacle(path[10]);
+
+		begin = BenchClock::now();
+		planner.Plan(start, target);
+		replanMs.push_back(ElapsedMs(begin));
+
+		map.SetStartPos(start);
+		begin = BenchClock::now();
+		map.Find_AStar_Path();
+		searchMs.push_back(ElapsedMs(begin));
+		if (planner.GetPathCost() != map.GetLastPathCost()) std::cout << "d* lite cost differs from a*" << std::endl;
+	}
+	const char* names[] = { "d* lite replan", "a* from scratch" };
+	std::vector<double>* times[] = { &replanMs, &searchMs };
+	for (int i = 0; i < 2; i++) {
+		std::vector<double>& t = *times[i];
+		if (t.empty()) continue;
+		double total = 0.0;
+		for (double ms : t) total += ms;
+		std::sort(t.begin(), t.end());
+		std::cout << names[i] << ": median " << std::setprecision(4) << t[t.size() / 2] << " ms, mean "
+			<< total / t.size() << " ms" << std::endl;
+	}
+}
+
+// agents all over the maze walking to one depot, the target stays while the starts change
+static void Run_ReverseTreeBenchmark(int gridSize)
+{
+	MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+	BuildScenario(map, Scenario::Maze);
+	MapGrid::GridPos depot = map.GetTargetPos();
+	std::mt19937 rng(4);
+	int rooms = gridSize / 2;
+	std::vector<MapGrid::GridPos> starts(200);
+	for (MapGrid::GridPos& start : starts) start = MapGrid::GridPos((rng() % rooms) * 2, (rng() % rooms) * 2);
+	std::cout << std::endl << "queries to one target on the maze scenario, " << starts.size() << " starts" << std::endl;
+
+	ReverseSearchTree tree(map);
+	std::vector<MapGrid::GridPos> path;
+	BenchClock::time_point begin = BenchClock::now();
+	for (const MapGrid::GridPos& start : starts) tree.FindPath(start, depot, path);
+	double treeMs = ElapsedMs(begin);
+	begin = BenchClock::now();
+	for (const MapGrid::GridPos& start : starts) tree.FindPath(start, depot, path);
+	double settledMs = ElapsedMs(begin);
+
+	const int searches = 10; // a full search per start takes long, a few are enough for the average
+	begin = BenchClock::now();
+	for (int i = 0; i < searches; i++) {
+		map.SetStartPos(starts[i]);
+		map.Find_AStar_Path();
+	}
+	double searchMs = ElapsedMs(begin) / searches;
+	std::cout << "reverse tree, growing: " << std::setprecision(4) << treeMs / starts.size() << " ms per query, "
+		<< tree.GetSettledCellCount() << " cells settled" << std::endl;
+	std::cout << "reverse tree, settled: " << std::setprecision(4) << settledMs / starts.size() << " ms per query" << std::endl;
+	std::cout << "a* per query: " << std::setprecision(4) << searchMs << " ms" << std::endl;
+}
+
+// one field towards the target of the map, many agents follow it
+static void Run_FlowFieldBenchmark(int gridSize)
+{
+	std::cout << std::endl << "flow field towards the target" << std::endl;
+	const MapGrid::Connectivity connectivities[] = { MapGrid::Connectivity::Four, MapGrid::Connectivity::Eight };
+	const Scenario scenarios[] = { Scenario::Open, Scenario::Maze };
+	for (MapGrid::Connectivity connectivity : connectivities) {
+		for (Scenario scenario : scenarios) {
+			MapGrid map(gridSize, gridSize, connectivity);
+			BuildScenario(map, scenario);
+			FlowField field(map);
+			BenchClock::time_point begin = BenchClock::now();
+			field.Build(map.GetTargetPos());
+			double buildMs = ElapsedMs(begin);
+
+			const int toggles = 10;
+			for (int i = 0; i < toggles; i++) {
+				map.ToggleObstacle(MapGrid::GridPos((i * 37 + 1) % gridSize, (i * 91 + 1) % gridSize));
+			}
+			begin = BenchClock::now();
+			field.Update();
+			double updateMs = ElapsedMs(begin);
+
+			// one step for every agent, like a frame of a crowd simulation
+			std::mt19937 rng(5);
+			std::vector<MapGrid::GridPos> agents(100000);
+			for (MapGrid::GridPos& agent : agents) agent = MapGrid::GridPos(rng() % gridSize, rng() % gridSize);
+			begin = BenchClock::now();
+			int moved = 0;
+			for (MapGrid::GridPos& agent : agents) moved += field.GetNextStep(agent, agent);
+			double stepNs = ElapsedMs(begin) * 1e6 / agents.size();
+
+			std::cout << (connectivity == MapGrid::Connectivity::Four ? "4" : "8") << " connected " << std::left << std::setw(8) << ScenarioName(scenario)
+				<< std::right << " build " << std::setprecision(3) << buildMs << " ms, update after " << toggles << " toggles "
+				<< updateMs << " ms, next step " << std::setprecision(1) << stepNs << " ns per agent (" << moved << " moved)" << std::endl;
+		}
+	}
+}
+
+// long queries on a random obstacle map, hierarchical search against flat A*
+static void Run_HierarchicalBenchmark(int gridSize)
+{
+	MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+	std::mt19937 rng(6);
+	for (int i = 0; i < gridSize * gridSize / 5; i++) {
+		map.ToggleObstacle(MapGrid::GridPos(rng() % gridSize, rng() % gridSize));
+	}
+	std::cout << std::endl << "hpa* on a random obstacle map, 32x32 clusters" << std::endl;
+
+	HpaStar hpa(map);
+	const int threadCounts[] = { 1, 0 };
+	for (int threads : threadCounts) {
+		BenchClock::time_point begin = BenchClock::now();
+		hpa.Build(threads);
+		std::cout << "build, " << (threads ? "1 thread" : "all cores") << ": " << std::setprecision(3) << ElapsedMs(begin) << " ms, "
+			<< hpa.GetClusterCount() << " clusters, " << hpa.GetNodeCount() << " nodes" << std::endl;
+	}
+	BenchClock::time_point begin = BenchClock::now();
+	map.ToggleObstacle(MapGrid::GridPos(gridSize / 2, gridSize / 2));
+	hpa.Update();
+	std::cout << "update after one ToggleObstacle: " << std::setprecision(3) << ElapsedMs(begin) << " ms, "
+		<< hpa.GetRebuiltClusterCount() << " clusters rebuilt" << std::endl;
+
+	const int queries = 10;
+	double abstractMs = 0.0;
+	double refineMs = 0.0;
+	double searchMs = 0.0;
+	double costRatio = 0.0;
+	std::vector<MapGrid::GridPos> path;
+	for (int i = 0; i < queries; i++) {
+		MapGrid::GridPos start(rng() % (gridSize / 4), rng() % (gridSize / 4));
+		MapGrid::GridPos target(gridSize - 1 - rng() % (gridSize / 4), gridSize - 1 - rng() % (gridSize / 4));
+		map.SetStartPos(start);
+		map.SetTargetPos(target);
+		hpa.Update(); // start and target cells are made free
+		begin = BenchClock::now();
+		hpa.FindAbstractPath(start, target);
+		abstractMs += ElapsedMs(begin);
+		begin = BenchClock::now();
+		path.assign(1, start);
+		for (size_t segment = 0; segment < hpa.GetSegmentCount(); segment++) hpa.RefineSegment(segment, path);
+		refineMs += ElapsedMs(begin);
+		begin = BenchClock::now();
+		map.Find_AStar_Path();
+		searchMs += ElapsedMs(begin);
+		costRatio += (double)hpa.GetPathCost() / map.GetLastPathCost();
+	}
+	std::cout << "abstract search " << std::setprecision(4) << abstractMs / queries << " ms, refinement " << refineMs / queries
+		<< " ms, a* " << searchMs / queries << " ms, path cost " << std::setprecision(3) << costRatio / queries << "x of a*" << std::endl;
+}
+
+// landmark table preprocessing on the maze, built once per thread count and reloaded from a file
+static void Run_LandmarkBenchmark(int gridSize)
+{
+	std::cout << std::endl << "alt landmarks on the maze scenario" << std::endl;
+	const MapGrid::Connectivity connectivities[] = { MapGrid::Connectivity::Four, MapGrid::Connectivity::Eight };
+	for (MapGrid::Connectivity connectivity : connectivities) {
+		MapGrid map(gridSize, gridSize, connectivity);
+		BuildScenario(map, Scenario::Maze);
+		const int threadCounts[] = { 1, 0 };
+		for (int threads : threadCounts) {
+			BenchClock::time_point begin = BenchClock::now();
+			map.BuildLandmarks(16, threads);
+			std::cout << (connectivity == MapGrid::Connectivity::Four ? "4" : "8") << " connected, " << map.GetLandmarks().GetLandmarkCount()
+				<< " landmarks, " << map.GetLandmarks().GetEntryBytes() << " bytes per entry, build " << (threads ? "1 thread" : "all cores")
+				<< ": " << std::setprecision(3) << ElapsedMs(begin) << " ms" << std::endl;
+		}
+		const char* fileName = "landmarks.bin";
+		BenchClock::time_point begin = BenchClock::now();
+		map.SaveLandmarks(fileName);
+		double saveMs = ElapsedMs(begin);
+		begin = BenchClock::now();
+		bool loaded = map.LoadLandmarks(fileName);
+		std::cout << "save " << std::setprecision(3) << saveMs << " ms, load " << ElapsedMs(begin) << " ms" << (loaded ? "" : " (failed)") << std::endl;
+		std::remove(fileName);
+	}
+}
+
+// first move table of a small maze, queries walk the table instead of searching
+static void Run_PathDatabaseBenchmark(int gridSize)
+{
+	int size = std::min(gridSize, 128); // one Dijkstra per cell, the build grows with the square of the cell count
+	MapGrid map(size, size, MapGrid::Connectivity::Eight);
+	BuildScenario(map, Scenario::Maze);
+	std::cout << std::endl << "compressed path database on a " << size << "x" << size << " maze" << std::endl;
+
+	PathDatabase database(map);
+	const int threadCounts[] = { 1, 0 };
+	for (int threads : threadCounts) {
+		BenchClock::time_point begin = BenchClock::now();
+		database.Build(threads);
+		std::cout << "build, " << (threads ? "1 thread" : "all cores") << ": " << std::setprecision(3) << ElapsedMs(begin) << " ms, "
+			<< database.GetRunCount() << " runs, " << database.GetMemoryBytes() / 1024 << " KiB" << std::endl;
+	}
+	const char* fileName = "paths.cpd";
+	database.Save(fileName);
+	PathDatabase mapped(map);
+	BenchClock::time_point begin = BenchClock::now();
+	bool loaded = mapped.Load(fileName);
+	std::cout << "memory mapped load: " << std::setprecision(3) << ElapsedMs(begin) << " ms" << (loaded ? "" : " (failed)") << std::endl;
+
+	std::vector<PathQuery> queries = MakeMazeQueries(size, 1000, size / 2);
+	std::vector<MapGrid::GridPos> path;
+	size_t cells = 0;
+	begin = BenchClock::now();
+	for (const PathQuery& query : queries) {
+		mapped.FindPath(query.start, query.target, path);
+		cells += path.size();
+	}
+	double databaseMs = ElapsedMs(begin);
+	SearchContext<MapGrid::Cost> context;
+	begin = BenchClock::now();
+	for (const PathQuery& query : queries) map.Find_AStar_Path(query.start, query.target, context);
+	double searchMs = ElapsedMs(begin);
+	std::cout << "per query: table walk " << std::setprecision(4) << databaseMs * 1000.0 / queries.size() << " us ("
+		<< cells / queries.size() << " cells), a* " << searchMs * 1000.0 / queries.size() << " us" << std::endl;
+	mapped.Clear();
+	std::remove(fileName);
+}
+
+// long queries, one and two directions against forward A*
+static void Run_BidirectionalBenchmark(int gridSize)
+{
+	std::cout << std::endl << "bidirectional a* against forward a*, start to target of the scenario" << std::endl;
+	const char* names[] = { "open", "maze", "pocket" };
+	for (int test = 0; test < 3; test++) {
+		MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+		BuildScenario(map, test == 1 ? Scenario::Maze : Scenario::Open);
+		if (test == 2) {
+			// the target sits at the closed end of a long pocket that opens away from the start, forward
+			// A* floods the open space in front of the pocket, the backward search walks straight out
+			int x0 = gridSize / 2;
+			int y0 = gridSize / 2;
+			map.SetStartPos(MapGrid::GridPos(gridSize / 8, y0));
+			map.SetTargetPos(MapGrid::GridPos(x0, y0));
+			for (int x = x0 - 1; x <= x0 + gridSize / 4; x++) {
+				map.ToggleObstacle(MapGrid::GridPos(x, y0 - 2));
+				map.ToggleObstacle(MapGrid::GridPos(x, y0 + 2));
+			}
+			for (int y = y0 - 1; y <= y0 + 1; y++) map.ToggleObstacle(MapGrid::GridPos(x0 - 1, y));
+		}
+		SearchContext<MapGrid::Cost> context;
+		BenchClock::time_point begin = BenchClock::now();
+		map.Search(MapGrid::Algorithm::AStar, map.GetStartPos(), map.GetTargetPos(), context);
+		double forwardMs = ElapsedMs(begin);
+
+		BidirectionalSearch search(map);
+		const bool threadModes[] = { false, true };
+		std::cout << std::left << std::setw(8) << names[test] << std::right << "a* " << std::setprecision(4) << forwardMs
+			<< " ms, " << context.expandedNodeCount << " expanded";
+		for (bool twoThreads : threadModes) {
+			begin = BenchClock::now();
+			search.Search(map.GetStartPos(), map.GetTargetPos(), twoThreads);
+			double ms = ElapsedMs(begin);
+			std::cout << (twoThreads ? ", two threads " : ", bidirectional ") << ms << " ms, " << search.GetExpandedNodeCount() << " expanded";
+			if (search.GetPathCost() != context.GetCost(context.target)) std::cout << " (cost differs)";
+		}
+		std::cout << std::endl;
+	}
+}
+
+// one ARA* query per budget, the cost and bound of the path it had when the budget ran out
+static void Run_AnytimeBenchmark(int gridSize)
+{
+	std::cout << std::endl << "ara* per query budget, cost against the shortest path (open has scattered obstacles)" << std::endl;
+	const Scenario scenarios[] = { Scenario::Open, Scenario::Maze };
+	const int budgetsUs[] = { 500, 4000, 32000, 128000 };
+	for (Scenario scenario : scenarios) {
+		MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+		BuildScenario(map, scenario);
+		if (scenario == Scenario::Open) {
+			// scattered obstacles, the inflated heuristic runs into them and detours
+			std::mt19937 rng(2);
+			for (int i = 0; i < gridSize * gridSize / 4; i++) {
+				MapGrid::GridPos pos((int)(rng() % gridSize), (int)(rng() % gridSize));
+				if (pos != map.GetStartPos() && pos != map.GetTargetPos() && !map.GetObstacleBitmap().Test(pos.first, pos.second)) map.ToggleObstacle(pos);
+			}
+		}
+		SearchContext<MapGrid::Cost> context;
+		BenchClock::time_point begin = BenchClock::now();
+		map.Search(MapGrid::Algorithm::AStar, map.GetStartPos(), map.GetTargetPos(), context);
+		double forwardMs = ElapsedMs(begin);
+		if (!context.IsCellVisited(context.target)) continue;
+		MapGrid::Cost shortest = context.GetCost(context.target);
+		std::cout << ScenarioName(scenario) << ": a* " << std::setprecision(4) << forwardMs << " ms, cost " << shortest << std::endl;
+
+		AraStar planner(map);
+		planner.Plan(map.GetStartPos(), map.GetTargetPos(), std::chrono::seconds(1)); // untimed, pages in the open list
+		for (int budgetUs : budgetsUs) {
+			begin = BenchClock::now();
+			bool found = planner.Plan(map.GetStartPos(), map.GetTargetPos(), std::chrono::microseconds(budgetUs));
+			double ms = ElapsedMs(begin);
+			std::cout << "  budget " << std::setw(6) << budgetUs << " us: " << std::setprecision(4) << ms << " ms, ";
+			if (!found) {
+				std::cout << "no path yet, " << planner.GetExpandedNodeCount() << " expanded" << std::endl;
+				continue;
+			}
+			std::cout << "cost " << planner.GetPathCost() << " (" << std::setprecision(4) << (double)planner.GetPathCost() / shortest
+				<< "x), bound " << planner.GetSuboptimalityBound() << (planner.IsOptimal() ? " optimal, " : ", ")
+				<< planner.GetExpandedNodeCount() << " expanded" << std::endl;
+		}
+	}
+}
+
+// long maze queries in flight at the same time, each frame gives the searches a fixed budget
+static void Run_SlicedSearchBenchmark(int gridSize)
+{
+	MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+	BuildScenario(map, Scenario::Maze);
+	std::vector<PathQuery> queries = MakeMazeQueries(gridSize, 8, gridSize / 8);
+	const std::chrono::microseconds frameBudget(1000);
+	std::cout << std::endl << "time sliced searches on the maze scenario, " << queries.size() << " a* queries in flight, "
+		<< frameBudget.count() << " us per frame" << std::endl;
+
+	// blocking searches, the longest one is the frame the window would freeze for
+	SearchContext<MapGrid::Cost> context;
+	double longestMs = 0.0;
+	double totalMs = 0.0;
+	for (PathQuery& query : queries) {
+		BenchClock::time_point begin = BenchClock::now();
+		map.Search(MapGrid::Algorithm::AStar, query.start, query.target, context);
+		double ms = ElapsedMs(begin);
+		query.cost = context.GetCost(context.target);
+		longestMs = std::max(longestMs, ms);
+		totalMs += ms;
+	}
+
+	SearchScheduler scheduler(map);
+	std::vector<int> tickets;
+	for (const PathQuery& query : queries) tickets.push_back(scheduler.Submit(query.start, query.target));
+	int frames = 0;
+	double longestFrameMs = 0.0;
+	double slicedMs = 0.0;
+	while (scheduler.GetRunningCount()) {
+		BenchClock::time_point begin = BenchClock::now();
+		scheduler.RunFrame(frameBudget);
+		double ms = ElapsedMs(begin);
+		longestFrameMs = std::max(longestFrameMs, ms);
+		slicedMs += ms;
+		frames++;
+	}
+	int mismatches = 0;
+	for (size_t i = 0; i < queries.size(); i++) {
+		MapGrid::Cost cost = scheduler.GetContext(tickets[i]).GetCost(queries[i].target.second * gridSize + queries[i].target.first);
+		if (scheduler.GetStatus(tickets[i]) != MapGrid::SearchStatus::Found || cost != queries[i].cost) mismatches++;
+	}
+	std::cout << "blocking: longest query " << std::setprecision(4) << longestMs << " ms, all " << totalMs << " ms" << std::endl;
+	std::cout << "sliced:   " << frames << " frames, longest frame " << longestFrameMs << " ms, all " << slicedMs << " ms";
+	if (mismatches) std::cout << ", " << mismatches << " costs differ";
+	std::cout << std::endl;
+}
+
+// any-angle waypoints against the grid path of A*, lengths in cells
+static void Run_ThetaStarBenchmark(int gridSize)
+{
+	std::cout << std::endl << "lazy theta* against a*, open has scattered obstacles" << std::endl;
+	const Scenario scenarios[] = { Scenario::Open, Scenario::Maze };
+	for (Scenario scenario : scenarios) {
+		MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+		BuildScenario(map, scenario);
+		if (scenario == Scenario::Open) {
+			std::mt19937 rng(2);
+			for (int i = 0; i < gridSize * gridSize / 8; i++) {
+				MapGrid::GridPos pos((int)(rng() % gridSize), (int)(rng() % gridSize));
+				if (pos != map.GetStartPos() && pos != map.GetTargetPos() && !map.GetObstacleBitmap().Test(pos.first, pos.second)) map.ToggleObstacle(pos);
+			}
+		}
+		SearchContext<MapGrid::Cost> context;
+		BenchClock::time_point begin = BenchClock::now();
+		map.Search(MapGrid::Algorithm::AStar, map.GetStartPos(), map.GetTargetPos(), context);
+		double forwardMs = ElapsedMs(begin);
+		std::vector<MapGrid::GridPos> path;
+		map.GetPath(context, path);
+
+		LazyThetaStar theta(map);
+		std::vector<MapGrid::GridPos> waypoints;
+		begin = BenchClock::now();
+		theta.FindPath(map.GetStartPos(), map.GetTargetPos(), waypoints);
+		double thetaMs = ElapsedMs(begin);
+		std::cout << std::left << std::setw(8) << ScenarioName(scenario) << std::right << "a* " << std::setprecision(4) << forwardMs << " ms, "
+			<< context.expandedNodeCount << " expanded, " << path.size() << " cells, length " << context.GetCost(context.target) / 1000.0 << std::endl;
+		std::cout << std::setw(8) << "" << "theta* " << thetaMs << " ms, " << theta.GetExpandedNodeCount() << " expanded, "
+			<< theta.GetLineOfSightCheckCount() << " line checks, " << waypoints.size() << " waypoints, length " << theta.GetPathCost() / 1000.0 << std::endl;
+	}
+}
+
+// grass with mud patches, with and without cheap roads. Roads keep the heuristic scale at 1
+static void Run_TerrainBenchmark(int gridSize)
+{
+	std::cout << std::endl << "terrain costs, grass 3 with mud 9 patches, roads 1 every 64 cells" << std::endl;
+	std::mt19937 rng(4);
+	std::vector<uint8_t> terrain((size_t)gridSize * gridSize, 3);
+	for (int patch = 0; patch < gridSize / 4; patch++) {
+		int px = rng() % gridSize;
+		int py = rng() % gridSize;
+		int radius = 4 + rng() % 28;
+		for (int y = std::max(0, py - radius); y < std::min(gridSize, py + radius); y++) {
+			for (int x = std::max(0, px - radius); x < std::min(gridSize, px + radius); x++) terrain[(size_t)y * gridSize + x] = 9;
+		}
+	}
+	std::vector<uint8_t> roads = terrain;
+	for (int line = 32; line < gridSize; line += 64) {
+		for (int i = 0; i < gridSize; i++) {
+			roads[(size_t)line * gridSize + i] = 1;
+			roads[(size_t)i * gridSize + line] = 1;
+		}
+	}
+
+	const char* names[] = { "uniform", "grass+mud", "with roads" };
+	const std::vector<uint8_t>* layers[] = { nullptr, &terrain, &roads };
+	for (int i = 0; i < 3; i++) {
+		MapGrid map(gridSize, gridSize, MapGrid::Connectivity::Eight);
+		BenchClock::time_point begin = BenchClock::now();
+		if (layers[i]) map.LoadTerrain(*layers[i]);
+		double loadMs = ElapsedMs(begin);
+		SearchContext<MapGrid::Cost> context;
+		map.Search(MapGrid::Algorithm::AStar, map.GetStartPos(), map.GetTargetPos(), context); // sizes the context
+		begin = BenchClock::now();
+		map.Search(MapGrid::Algorithm::AStar, map.GetStartPos(), map.GetTargetPos(), context);
+		double searchMs = ElapsedMs(begin);
+		std::cout << std::left << std::setw(11) << names[i] << std::right << "load " << std::setprecision(3) << loadMs << " ms, min cost "
+			<< (int)map.GetMinTerrainCost() << ", a* " << std::setprecision(4) << searchMs << " ms, " << context.expandedNodeCount
+			<< " expanded, cost " << context.GetCost(context.target) << std::endl;
+	}
+}
+
+void Run_Benchmark(int gridSize)
+{
+	const Scenario scenarios[] = { Scenario::Open, Scenario::Maze, Scenario::NoPath, Scenario::Short };
+	// bucket queue engines share one search context, it is reused between runs like the map's own
+	std::shared_ptr<BucketSearchContext<MapGrid::Cost>> bucket = std::make_shared<BucketSearchContext<MapGrid::Cost>>();
+	const BenchEngine engines[] = {
+		{ "astar4", MapGrid::Connectivity::Four, [](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_AStar_Path();
+			expanded = map.GetExpandedNodeCount();
+			return path;
+		}, nullptr },
+		{ "astar4-bq", MapGrid::Connectivity::Four, [bucket](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_AStar_Path(*bucket);
+			expanded = bucket->expandedNodeCount;
+			return path;
+		}, nullptr },
+		{ "astar8", MapGrid::Connectivity::Eight, [](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_AStar_Path();
+			expanded = map.GetExpandedNodeCount();
+			return path;
+		}, nullptr },
+		{ "astar8-bq", MapGrid::Connectivity::Eight, [bucket](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_AStar_Path(*bucket);
+			expanded = bucket->expandedNodeCount;
+			return path;
+		}, nullptr },
+		{ "astar8-cc", MapGrid::Connectivity::Eight, [](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_AStar_Path();
+			expanded = map.GetExpandedNodeCount();
+			return path;
+		}, [](MapGrid& map) { map.BuildComponentLabels(); } },
+		{ "jps", MapGrid::Connectivity::Eight, [](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_JPS_Path();
+			expanded = map.GetExpandedNodeCount();
+			return path;
+		}, nullptr },
+		{ "jps-bq", MapGrid::Connectivity::Eight, [bucket](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_JPS_Path(*bucket);
+			expanded = bucket->expandedNodeCount;
+			return path;
+		}, nullptr },
+		{ "jps+", MapGrid::Connectivity::Eight, [](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_JPSPlus_Path();
+			expanded = map.GetExpandedNodeCount();
+			return path;
+		}, [](MapGrid& map) { map.BuildJpsPlusTable(); } },
+		{ "alt4", MapGrid::Connectivity::Four, [](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_ALT_Path();
+			expanded = map.GetExpandedNodeCount();
+			return path;
+		}, [](MapGrid& map) { map.BuildLandmarks(); } },
+		{ "alt8", MapGrid::Connectivity::Eight, [](MapGrid& map, int& expanded) {
+			std::vector<MapGrid::GridPos> path = map.Find_ALT_Path();
+			expanded = map.GetExpandedNodeCount();
+			return path;
+		}, [](MapGrid& map) { map.BuildLandmarks(); } },
+	};
+	const int repeats = 5;
+
+	std::cout << "grid size: " << gridSize << "x" << gridSize << ", best of " << repeats << " runs" << std::endl;
+	std::cout << std::left << std::setw(10) << "engine" << std::setw(10) << "scenario"
+		<< std::right << std::setw(12) << "expanded" << std::setw(10) << "path" << std::setw(12) << "cost"
+		<< std::setw(12) << "time(ms)" << std::setw(16) << "expanded/s" << std::endl;
+
+	for (Scenario scenario : scenarios) {
+		for (const BenchEngine& engine : engines) {
+			MapGrid map(gridSize, gridSize, engine.connectivity);
+			BuildScenario(map, scenario);
+			if (engine.prepare) engine.prepare(map);
+
+			double bestMs = 0.0;
+			int expanded = 0;
+			std::vector<MapGrid::GridPos> path;
+			for (int i = 0; i < repeats; i++) {
+				BenchClock::time_point begin = BenchClock::now();
+				path = engine.query(map, expanded);
+				double ms = std::chrono::duration<double, std::milli>(BenchClock::now() - begin).count();
+				if (i == 0 || ms < bestMs) bestMs = ms;
+			}
+			PrintResult(engine.name, scenario, expanded, path, bestMs);
+		}
+	}
+
+	Run_PreprocessingBenchmark(gridSize);
+	Run_BatchBenchmark(gridSize);
+	Run_ReplanningBenchmark(gridSize);
+	Run_ReverseTreeBenchmark(gridSize);
+	Run_FlowFieldBenchmark(gridSize);
+	Run_HierarchicalBenchmark(gridSize);
+	Run_LandmarkBenchmark(gridSize);
+	Run_PathDatabaseBenchmark(gridSize);
+	Run_BidirectionalBenchmark(gridSize);
+	Run_AnytimeBenchmark(gridSize);
+	Run_SlicedSearchBenchmark(gridSize);
+	Run_ThetaStarBenchmark(gridSize);
+	Run_TerrainBenchmark(gridSize);
+}
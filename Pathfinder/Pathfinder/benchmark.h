@@ -0,0 +1,15 @@
+/**
+  ******************************************************************************
+  * @file    benchmark.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the pathfinding benchmark
+  ******************************************************************************
+  */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+void Run_Benchmark(int gridSize);
+
+#endif
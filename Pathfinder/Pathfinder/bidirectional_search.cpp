@@ -0,0 +1,241 @@
+/**
+  ******************************************************************************
+  * @file    bidirectional_search.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the implementation of the bidirectional A* search.
+  ******************************************************************************
+  */
+#include "bidirectional_search.h"
+#include <algorithm>
+#include <thread>
+
+const uint32_t BidirectionalSearch::NO_CELL;
+
+static const uint64_t NO_MEETING = ((uint64_t)MapGrid::COST_INFINITY << 32) | 0xFFFFFFFFu;
+
+BidirectionalSearch::BidirectionalSearch(const MapGrid& map) : _Map(map), _Best(NO_MEETING), _Stop(false)
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	size_t cellCount = (size_t)size.first * size.second;
+	_SizeX = size.first;
+	_NeighbourCount = map.GetNeighbourCount();
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		_DirX[dir] = offset.first;
+		_DirY[dir] = offset.second;
+		_StepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	for (int side = FORWARD; side <= BACKWARD; side++) {
+		_Side[side].Prepare((int)cellCount);
+		_Settled[side].reset(new std::atomic<uint64_t>[cellCount]);
+		for (size_t cell = 0; cell < cellCount; cell++) _Settled[side][cell].store(0, std::memory_order_relaxed);
+	}
+}
+
+bool BidirectionalSearch::Search(GridPos startPos, GridPos targetPos, bool twoThreads)
+{
+	_Found = false;
+	_Best.store(NO_MEETING);
+	_Stop.store(false);
+	for (int side = FORWARD; side <= BACKWARD; side++) _Side[side].BeginSearch((int)_Side[side].searchIds.size());
+	const ObstacleBitmap& obstacles = _Map.GetObstacleBitmap();
+	if (obstacles.Test(startPos.first, startPos.second) || obstacles.Test(targetPos.first, targetPos.second)) return false;
+	if (!_Map.AreConnected(startPos, targetPos)) return false;
+
+	_SearchId++;
+	if (_SearchId == 0) {
+		// counter wrapped around, old entries could be mistaken for the current search
+		size_t cellCount = _Side[FORWARD].searchIds.size();
+		for (int side = FORWARD; side <= BACKWARD; side++) {
+			for (size_t cell = 0; cell < cellCount; cell++) _Settled[side][cell].store(0, std::memory_order_relaxed);
+		}
+		_SearchId = 1;
+	}
+
+	uint32_t root[2] = { (uint32_t)(startPos.second * _SizeX + startPos.first), (uint32_t)(targetPos.second * _SizeX + targetPos.first) };
+	for (int side = FORWARD; side <= BACKWARD; side++) {
+		SearchContext<Cost>& context = _Side[side];
+		_Goal[side] = root[1 - side];
+		context.start = root[side];
+		context.target = root[1 - side];
+		context.TouchCell(root[side]);
+		context.localGoal[root[side]] = 0;
+		context.OpenCell(root[side], Key(0, root[side], side));
+		_LowestKey[side].store(0);
+	}
+	// both roots count as settled before any thread starts, so a direction that reaches
+	// the other root always sees it
+	for (int side = FORWARD; side <= BACKWARD; side++) {
+		_Settled[side][root[side]].store(((uint64_t)_SearchId << 32), std::memory_order_relaxed);
+	}
+	if (root[FORWARD] == root[BACKWARD]) _Best.store(root[FORWARD]);
+
+	if (twoThreads) {
+		std::thread backward([this]() { RunSide(BACKWARD); });
+		RunSide(FORWARD);
+		backward.join();
+	}
+	else {
+		while (!_Side[FORWARD].openList.Empty() && !_Side[BACKWARD].openList.Empty()) {
+			// the smaller frontier grows, a direction stuck in front of an obstacle widens its open list
+			// and hands the work to the other one. The best meeting is shortest once it costs no more
+			// than the higher lowest f, see CanStop
+			Cost forwardKey = _Side[FORWARD].openList.TopKey();
+			Cost backwardKey = _Side[BACKWARD].openList.TopKey();
+			if ((_Best.load(std::memory_order_relaxed) >> 32) <= std::max(forwardKey, backwardKey)) break;
+			Expand(_Side[FORWARD].openList.Size() <= _Side[BACKWARD].openList.Size() ? FORWARD : BACKWARD);
+		}
+	}
+	_Found = (_Best.load() >> 32) != MapGrid::COST_INFINITY;
+	return _Found;
+}
+
+void BidirectionalSearch::RunSide(int side)
+{
+	while (!_Stop.load(std::memory_order_relaxed)) {
+		// a direction that ran out of cells has settled everything it can reach, the target included if there is a path
+		if (_Side[side].openList.Empty() || CanStop(side)) {
+			_Stop.store(true, std::memory_order_relaxed);
+			break;
+		}
+		Expand(side);
+	}
+}
+
+/**
+  * @brief  While a shorter path than the best meeting exists, the forward search has an open
+  *         cell on it with an exact cost, so its lowest f is at most the shortest path. The
+  *         same holds for the backward search, so the best meeting is shortest once it costs
+  *         no more than either lowest f. The other direction's published f was its lowest f
+  *         when it was published, that is enough for the same argument.
+  */
+bool BidirectionalSearch::CanStop(int side) const
+{
+	Cost lowest = std::max(_Side[side].openList.TopKey(), _LowestKey[1 - side].load(std::memory_order_relaxed));
+	return (_Best.load(std::memory_order_relaxed) >> 32) <= lowest;
+}
+
+void BidirectionalSearch::Expand(int side)
+{
+	SearchContext<Cost>& context = _Side[side];
+	_LowestKey[side].store(context.openList.TopKey(), std::memory_order_relaxed);
+	uint32_t current = context.openList.Pop();
+	context.MarkVisited(current);
+	Settle(side, current, context.localGoal[current]);
+
+	// moves are symmetric, the backward direction uses the forward move rules
+	int cx = current % _SizeX;
+	int cy = current / _SizeX;
+	for (int dir = 0; dir < _NeighbourCount; dir++) {
+		if (!_Map.IsMoveAllowed(cx, cy, _DirX[dir], _DirY[dir])) continue;
+		uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+		if (context.IsCellVisited(neighbour)) continue; // the heuristic is consistent, settled costs are exact
+		context.TouchCell(neighbour);
+		Cost localGoal = context.localGoal[current] + _StepCost[dir];
+		// offered even without an improvement, a cell reached as cheaply before may have been
+		// settled by the other direction since
+		OfferMeeting(side, neighbour, localGoal);
+		if (localGoal < context.localGoal[neighbour]) {
+			context.parent[neighbour] = current;
+			context.localGoal[neighbour] = localGoal;
+			context.OpenCell(neighbour, Key(localGoal, neighbour, side));
+		}
+	}
+}
+
+void BidirectionalSearch::Settle(int side, uint32_t cell, Cost cost)
+{
+	// both threads store their own cell and then load the other one's. Only a single total order
+	// makes sure that at least one of them sees the other when they settle the same cell
+	_Settled[side][cell].store(((uint64_t)_SearchId << 32) | cost, std::memory_order_seq_cst);
+	OfferMeeting(side, cell, cost);
+}
+
+void BidirectionalSearch::OfferMeeting(int side, uint32_t cell, Cost cost)
+{
+	uint64_t other = _Settled[1 - side][cell].load(std::memory_order_seq_cst);
+	if ((uint32_t)(other >> 32) != _SearchId) return;
+	uint64_t total = (uint64_t)cost + (uint32_t)other;
+	if (total >= MapGrid::COST_INFINITY) return;
+	uint64_t meeting = (total << 32) | cell;
+	uint64_t best = _Best.load(std::memory_order_relaxed);
+	while (meeting < best && !_Best.compare_exchange_weak(best, meeting)) {}
+}
+
+size_t BidirectionalSearch::ChainLength(int side, uint32_t cell) const
+{
+	size_t length = 1;
+	for (; cell != _Side[side].start; cell = _Side[side].parent[cell]) length++;
+	return length;
+}
+
+size_t BidirectionalSearch::GetPathCells(Span<uint32_t> cells) const
+{
+	if (!_Found) return 0;
+	uint32_t meeting = (uint32_t)_Best.load();
+	// the meeting cell ends the forward chain, the backward chain follows without it
+	size_t forward = ChainLength(FORWARD, meeting);
+	size_t cellCount = forward + ChainLength(BACKWARD, meeting) - 1;
+	if (cells.size() < cellCount) return cellCount;
+	size_t index = forward;
+	for (uint32_t cell = meeting;; cell = _Side[FORWARD].parent[cell]) {
+		cells[--index] = cell;
+		if (cell == _Side[FORWARD].start) break;
+	}
+	index = forward;
+	for (uint32_t cell = meeting; cell != _Side[BACKWARD].start;) {
+		cell = _Side[BACKWARD].parent[cell];
+		cells[index++] = cell;
+	}
+	return cellCount;
+}
+
+void BidirectionalSearch::GetPath(std::vector<GridPos>& path) const
+{
+	path.clear();
+	if (!_Found) return;
+	uint32_t meeting = (uint32_t)_Best.load();
+	size_t forward = ChainLength(FORWARD, meeting);
+	path.resize(forward + ChainLength(BACKWARD, meeting) - 1);
+	size_t index = forward;
+	for (uint32_t cell = meeting;; cell = _Side[FORWARD].parent[cell]) {
+		path[--index] = GridPos(cell % _SizeX, cell / _SizeX);
+		if (cell == _Side[FORWARD].start) break;
+	}
+	index = forward;
+	for (uint32_t cell = meeting; cell != _Side[BACKWARD].start;) {
+		cell = _Side[BACKWARD].parent[cell];
+		path[index++] = GridPos(cell % _SizeX, cell / _SizeX);
+	}
+}
+
+bool BidirectionalSearch::FindPath(GridPos start, GridPos target, std::vector<GridPos>& path, bool twoThreads)
+{
+	bool found = Search(start, target, twoThreads);
+	GetPath(path);
+	return found;
+}
+
+MapGrid::Cost BidirectionalSearch::GetPathCost(void) const
+{
+	return _Found ? (Cost)(_Best.load() >> 32) : MapGrid::COST_INFINITY;
+}
+
+int BidirectionalSearch::GetExpandedNodeCount(void) const
+{
+	return _Side[FORWARD].expandedNodeCount + _Side[BACKWARD].expandedNodeCount;
+}
+
+MapGrid::Cost BidirectionalSearch::Key(Cost cost, uint32_t cell, int side) const
+{
+	return cost + Heuristic(cell, _Goal[side]);
+}
+
+MapGrid::Cost BidirectionalSearch::Heuristic(uint32_t a, uint32_t b) const
+{
+	int dx = (int)(a % _SizeX) - (int)(b % _SizeX);
+	int dy = (int)(a / _SizeX) - (int)(b / _SizeX);
+	if (_NeighbourCount == 4) return ManhattanCost<Cost>(dx, dy);
+	return OctileCost<Cost>(dx, dy);
+}
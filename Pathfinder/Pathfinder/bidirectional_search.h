@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    bidirectional_search.h
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the declaration of the bidirectional A* search.
+  *          One A* grows from the start towards the target and one from the
+  *          target towards the start, each keyed by f = g + h to its own goal.
+  *          Whenever a search reaches a cell the other one has settled, the sum
+  *          of both costs is a path and the cheapest one seen is kept. The search
+  *          stops once the best path costs no more than the higher of the two
+  *          lowest f values, and grows the direction with the smaller open list
+  *          first. A target in a pocket that opens away from the start costs the
+  *          forward search a wide flood in front of it, while the backward search
+  *          walks out of the pocket along a thin line and ends the query early.
+  *          The two directions can run on two threads, they only share the
+  *          settled costs, their lowest keys and the best meeting.
+  ******************************************************************************
+  */
+
+#ifndef BIDIRECTIONAL_SEARCH_H
+#define BIDIRECTIONAL_SEARCH_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "map_grid.h"
+#include "search_context.h"
+#include "span.h"
+
+class BidirectionalSearch {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::Cost Cost;
+
+	// the search keeps a reference to the map, it must outlive the search
+	BidirectionalSearch(const MapGrid& map);
+	// true if a path is found, twoThreads runs the backward search on a second thread
+	bool Search(GridPos start, GridPos target, bool twoThreads = false);
+	// path of the last search, start first. Both parent chains are written straight into the output
+	void GetPath(std::vector<GridPos>& path) const; // reuses the vector's storage
+	size_t GetPathCells(Span<uint32_t> cells) const; // cells (y * width + x) if they fit, returns the size needed
+	bool FindPath(GridPos start, GridPos target, std::vector<GridPos>& path, bool twoThreads = false);
+	Cost GetPathCost(void) const; // cost of the last path or COST_INFINITY
+	int GetExpandedNodeCount(void) const; // both directions of the last search
+
+private:
+	enum { FORWARD = 0, BACKWARD = 1 };
+	static const uint32_t NO_CELL = 0xFFFFFFFFu;
+
+	const MapGrid& _Map;
+	int _SizeX = 0;
+	int _DirX[8];
+	int _DirY[8];
+	Cost _StepCost[8];
+	int _NeighbourCount = 4;
+
+	SearchContext<Cost> _Side[2];
+	uint32_t _Goal[2]; // cell each direction is heading to
+	// settled cost of every cell per direction as (search id << 32) | cost, read by the other direction
+	std::unique_ptr<std::atomic<uint64_t>[]> _Settled[2];
+	uint32_t _SearchId = 0;
+	std::atomic<uint64_t> _Best; // (cost << 32) | meeting cell of the cheapest path seen
+	std::atomic<Cost> _LowestKey[2]; // f of the cell each direction expanded last, the heuristic is consistent so it only rises
+	std::atomic<bool> _Stop;
+	bool _Found = false;
+
+	void Settle(int side, uint32_t cell, Cost cost);
+	void OfferMeeting(int side, uint32_t cell, Cost cost); // cost from the side's own root
+	void Expand(int side);
+	bool CanStop(int side) const; // the best meeting is shortest as far as this direction can tell
+	void RunSide(int side); // one direction alone, used by the threads
+	Cost Key(Cost cost, uint32_t cell, int side) const; // f of a cell reached at cost
+	Cost Heuristic(uint32_t a, uint32_t b) const;
+	size_t ChainLength(int side, uint32_t cell) const; // cells from the root of the side to cell
+};
+
+#endif
@@ -0,0 +1,241 @@
+/**
+  ******************************************************************************
+  * @file    bucket_queue.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the bucket queue (Dial's algorithm) open list for
+  *          integer costs. Keys in [base, base + BUCKET_COUNT) index a circular
+  *          array of buckets, a two level bitmap of the non empty buckets finds
+  *          the lowest key with two bit scans even though fixed point keys leave
+  *          most buckets empty. Keys past the window wait in an overflow heap
+  *          until the window reaches them, which only happens for long jumps.
+  *          Inside a bucket the entry with the largest cost from start is popped
+  *          first: a bucket is sorted once when it becomes the lowest one, after
+  *          that new entries come from its own cells and have larger costs than
+  *          the rest, so they are simply appended. Improved items are pushed
+  *          again, the old entries are skipped when they come out of the queue.
+  ******************************************************************************
+  */
+
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "obstacle_bitmap.h"
+
+template <typename KeyT>
+class BucketQueue {
+	static_assert(std::is_integral<KeyT>::value, "bucket queue needs integer keys");
+
+public:
+	// covers the key range of A* with the fixed point step costs, a new key is at most two diagonal steps above the lowest one
+	static const size_t BUCKET_COUNT = 4096;
+
+	BucketQueue(size_t capacity = 0)
+	{
+		Resize(capacity);
+	}
+
+	// capacity is the number of different item ids (e.g. number of grid cells)
+	void Resize(size_t capacity)
+	{
+		_Key.assign(capacity, 0);
+		_Queued.assign(capacity, 0);
+		_Buckets.assign(BUCKET_COUNT, std::vector<Entry>());
+		_Sorted.assign(BUCKET_COUNT, 0);
+		_Overflow.clear();
+		for (uint64_t& word : _Occupied) word = 0;
+		_Summary = 0;
+		_Base = 0;
+		_Count = 0;
+	}
+
+	// only the occupied buckets are touched, so clearing is cheap
+	void Clear()
+	{
+		while (_Summary) {
+			size_t word = CountTrailingZeros64(_Summary);
+			while (_Occupied[word]) {
+				size_t idx = word * 64 + CountTrailingZeros64(_Occupied[word]);
+				for (const Entry& e : _Buckets[idx]) _Queued[e.id] = 0;
+				_Buckets[idx].clear();
+				_Sorted[idx] = 0;
+				_Occupied[word] &= _Occupied[word] - 1;
+			}
+			_Summary &= _Summary - 1;
+		}
+		for (const Entry& e : _Overflow) _Queued[e.id] = 0;
+		_Overflow.clear();
+		_Count = 0;
+	}
+
+	bool Empty() const { return _Count == 0; }
+	size_t Size() const { return _Count; }
+	bool Contains(uint32_t id) const { return _Queued[id] != 0; }
+
+	// tieBreak is the cost from start of the item, larger values leave an equal key bucket first
+	void PushOrDecrease(uint32_t id, KeyT key, KeyT tieBreak)
+	{
+		if (_Count == 0) {
+			// only stale entries are left, the window can start at the new key
+			Clear();
+			_Base = key;
+		}
+		if (key < _Base) MoveWindowDown(key); // not needed by A* with a consistent heuristic
+		if (!Contains(id)) _Count++;
+		_Queued[id] = 1;
+		_Key[id] = key;
+		Entry entry = { tieBreak, key, id };
+		if ((size_t)(key - _Base) < BUCKET_COUNT) {
+			Insert(entry);
+		}
+		else {
+			_Overflow.push_back(entry);
+			std::push_heap(_Overflow.begin(), _Overflow.end(), OverflowOrder);
+		}
+	}
+
+	uint32_t Pop()
+	{
+		while (true) {
+			if (_Summary == 0) {
+				// window is empty, move it to the lowest waiting key
+				_Base = _Overflow.front().key;
+				RefillFromOverflow();
+				continue;
+			}
+			size_t idx = FindOccupiedBucket();
+			std::vector<Entry>& bucket = _Buckets[idx];
+			KeyT bucketKey = _Base + (KeyT)((idx - (size_t)(_Base & MASK)) & MASK);
+			if (bucketKey != _Base) {
+				// keys below this bucket are gone, waiting keys may fit the window now. They are
+				// all above the keys of the old window, so this bucket stays the lowest one
+				_Base = bucketKey;
+				RefillFromOverflow();
+			}
+			if (!_Sorted[idx]) {
+				// ascending, equal costs are ordered by id so the result does not depend on the
+				// sort. std::sort does not allocate, unlike std::stable_sort
+				std::sort(bucket.begin(), bucket.end(), [](const Entry& a, const Entry& b) {
+					return a.tieBreak < b.tieBreak || (a.tieBreak == b.tieBreak && a.id < b.id);
+				});
+				_Sorted[idx] = 1;
+			}
+			Entry entry = bucket.back();
+			bucket.pop_back();
+			if (bucket.empty()) {
+				_Sorted[idx] = 0;
+				_Occupied[idx >> 6] &= ~(1ull << (idx & 63));
+				if (_Occupied[idx >> 6] == 0) _Summary &= ~(1ull << (idx >> 6));
+			}
+			// entries of items that were improved or already popped are stale
+			if (!_Queued[entry.id] || _Key[entry.id] != entry.key) continue;
+			_Queued[entry.id] = 0;
+			_Count--;
+			return entry.id;
+		}
+	}
+
+private:
+	static const size_t MASK = BUCKET_COUNT - 1;
+	static const size_t OCCUPIED_WORDS = BUCKET_COUNT / 64; // fits in the 64 bits of the summary word
+
+	struct Entry {
+		KeyT tieBreak;
+		KeyT key;
+		uint32_t id;
+	};
+
+	std::vector<std::vector<Entry>> _Buckets; // circular, key k lives in bucket k & MASK
+	std::vector<uint8_t> _Sorted; // 1 if the bucket is ordered by tie break value
+	std::vector<Entry> _Overflow; // min heap of the keys past the window
+	uint64_t _Occupied[OCCUPIED_WORDS] = {}; // one bit per non empty bucket
+	uint64_t _Summary = 0; // one bit per non zero word of _Occupied
+	std::vector<KeyT> _Key; // latest key of each item
+	std::vector<uint8_t> _Queued; // 1 if the item is in the queue
+	KeyT _Base = 0; // lowest key that can be in the queue
+	size_t _Count = 0; // number of queued items, stale entries are not counted
+
+	static bool OverflowOrder(const Entry& a, const Entry& b)
+	{
+		return a.key > b.key;
+	}
+
+	void Insert(const Entry& entry)
+	{
+		size_t idx = (size_t)(entry.key & MASK);
+		std::vector<Entry>& bucket = _Buckets[idx];
+		bucket.push_back(entry);
+		if (_Sorted[idx]) {
+			// keep the order of the bucket being popped, the loop rarely runs
+			size_t pos = bucket.size() - 1;
+			while (pos > 0 && bucket[pos - 1].tieBreak > entry.tieBreak) {
+				bucket[pos] = bucket[pos - 1];
+				pos--;
+			}
+			bucket[pos] = entry;
+		}
+		_Occupied[idx >> 6] |= 1ull << (idx & 63);
+		_Summary |= 1ull << (idx >> 6);
+	}
+
+	// first occupied bucket at or after the base bucket going around the ring, the ring must not be empty
+	size_t FindOccupiedBucket() const
+	{
+		size_t start = (size_t)(_Base & MASK);
+		size_t word = start >> 6;
+		uint64_t bits = _Occupied[word] & (~0ull << (start & 63));
+		if (bits) return (word << 6) + CountTrailingZeros64(bits);
+
+		// next non zero word after the start word, then wrap around to the lower words
+		uint64_t words = (word == 63) ? 0 : (_Summary & (~0ull << (word + 1)));
+		if (!words) words = _Summary;
+		size_t found = CountTrailingZeros64(words);
+		return (found << 6) + CountTrailingZeros64(_Occupied[found]);
+	}
+
+	// moves the waiting entries that fit the window into the buckets, stale ones are dropped
+	void RefillFromOverflow()
+	{
+		while (!_Overflow.empty() && (size_t)(_Overflow.front().key - _Base) < BUCKET_COUNT) {
+			Entry entry = _Overflow.front();
+			std::pop_heap(_Overflow.begin(), _Overflow.end(), OverflowOrder);
+			_Overflow.pop_back();
+			if (_Queued[entry.id] && _Key[entry.id] == entry.key) Insert(entry);
+		}
+	}
+
+	// starts the window at a key below the current base, every bucketed entry waits in the overflow heap again
+	void MoveWindowDown(KeyT key)
+	{
+		while (_Summary) {
+			size_t word = CountTrailingZeros64(_Summary);
+			while (_Occupied[word]) {
+				size_t idx = word * 64 + CountTrailingZeros64(_Occupied[word]);
+				for (const Entry& e : _Buckets[idx]) {
+					_Overflow.push_back(e);
+					std::push_heap(_Overflow.begin(), _Overflow.end(), OverflowOrder);
+				}
+				_Buckets[idx].clear();
+				_Sorted[idx] = 0;
+				_Occupied[word] &= _Occupied[word] - 1;
+			}
+			_Summary &= _Summary - 1;
+		}
+		_Base = key;
+		RefillFromOverflow();
+	}
+};
+
+template <typename KeyT>
+const size_t BucketQueue<KeyT>::BUCKET_COUNT;
+template <typename KeyT>
+const size_t BucketQueue<KeyT>::MASK;
+template <typename KeyT>
+const size_t BucketQueue<KeyT>::OCCUPIED_WORDS;
+
+#endif
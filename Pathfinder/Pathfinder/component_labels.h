@@ -0,0 +1,104 @@
+/**
+  ******************************************************************************
+  * @file    component_labels.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the connected component labels of the free cells.
+  *          Every free cell points to a node of a union-find forest, two cells
+  *          are connected when their nodes have the same root. A full sweep
+  *          leaves every label pointing at its root, so a lookup is two reads.
+  *          Freed cells get a new node that is joined with the neighbours, the
+  *          nodes are linked by size so the trees stay shallow until the next
+  *          sweep. The owner sweeps again once the freed cells doubled the node
+  *          count, so painting cells free and blocked does not grow the forest
+  *          without bound. Lookups never compress paths and can run on many threads.
+  ******************************************************************************
+  */
+
+#ifndef COMPONENT_LABELS_H
+#define COMPONENT_LABELS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+class ComponentLabels {
+public:
+	static const uint32_t NO_COMPONENT = 0xFFFFFFFFu; // label of the blocked cells
+
+	// every cell becomes its own node, the labels are set by the caller
+	void Reset(size_t cellCount)
+	{
+		_Labels.assign(cellCount, NO_COMPONENT);
+		_Parent.resize(cellCount);
+		_Size.assign(cellCount, 1);
+		for (size_t i = 0; i < cellCount; i++) _Parent[i] = (uint32_t)i;
+	}
+	void Clear(void)
+	{
+		_Labels.clear();
+		_Parent.clear();
+		_Size.clear();
+	}
+	bool IsBuilt(void) const { return !_Labels.empty(); }
+
+	uint32_t GetLabel(uint32_t cell) const { return _Labels[cell]; }
+	void SetLabel(uint32_t cell, uint32_t node) { _Labels[cell] = node; }
+
+	// component of a cell, NO_COMPONENT for blocked cells
+	uint32_t GetComponent(uint32_t cell) const
+	{
+		uint32_t node = _Labels[cell];
+		return node == NO_COMPONENT ? NO_COMPONENT : FindRoot(node);
+	}
+	bool AreConnected(uint32_t a, uint32_t b) const
+	{
+		uint32_t component = GetComponent(a);
+		return component != NO_COMPONENT && component == GetComponent(b);
+	}
+
+	size_t GetNodeCount(void) const { return _Parent.size(); } // cells of the last reset plus the added nodes
+	// new single node for a freed cell
+	uint32_t AddNode(void)
+	{
+		_Parent.push_back((uint32_t)_Parent.size());
+		_Size.push_back(1);
+		return (uint32_t)_Parent.size() - 1;
+	}
+
+	// root of a node with path halving, only used while the labels are being written
+	uint32_t FindAndCompress(uint32_t node)
+	{
+		while (_Parent[node] != node) {
+			_Parent[node] = _Parent[_Parent[node]];
+			node = _Parent[node];
+		}
+		return node;
+	}
+
+	// joins the trees of two nodes, returns the root of the joined tree
+	uint32_t Union(uint32_t a, uint32_t b)
+	{
+		a = FindAndCompress(a);
+		b = FindAndCompress(b);
+		if (a == b) return a;
+		if (_Size[a] < _Size[b]) std::swap(a, b);
+		_Parent[b] = a;
+		_Size[a] += _Size[b];
+		return a;
+	}
+
+private:
+	std::vector<uint32_t> _Labels; // node of each cell
+	std::vector<uint32_t> _Parent; // union-find forest, roots point to themselves
+	std::vector<uint32_t> _Size; // cells below each root, used to keep the trees shallow
+
+	uint32_t FindRoot(uint32_t node) const
+	{
+		while (_Parent[node] != node) node = _Parent[node];
+		return node;
+	}
+};
+
+#endif
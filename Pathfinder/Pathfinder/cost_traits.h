@@ -0,0 +1,80 @@
+/**
+  ******************************************************************************
+  * @file    cost_traits.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the cost types the grid searches can run with.
+  *          Integer costs are fixed point with 1000 units per cell, so step costs
+  *          and heuristics are exact integers and the results do not depend on
+  *          the compiler. Floating point costs are kept for comparison.
+  ******************************************************************************
+  */
+
+#ifndef COST_TRAITS_H
+#define COST_TRAITS_H
+
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+template <typename CostT>
+struct CostTraits;
+
+// fixed point, 1 unit = 1/1000 cell. 32 bits are enough for paths of about four million cells
+template <>
+struct CostTraits<uint32_t> {
+	static uint32_t Straight(void) { return 1000; }
+	static uint32_t Diagonal(void) { return 1414; } // sqrt(2) cells
+	static uint32_t Infinity(void) { return std::numeric_limits<uint32_t>::max(); }
+	static uint32_t Add(uint32_t a, uint32_t b) { return (a > Infinity() - b) ? Infinity() : a + b; } // stops at infinity instead of wrapping
+	static double ToCells(uint32_t cost) { return cost / 1000.0; }
+};
+
+// fixed point for very long paths on big maps
+template <>
+struct CostTraits<uint64_t> {
+	static uint64_t Straight(void) { return 1000; }
+	static uint64_t Diagonal(void) { return 1414; }
+	static uint64_t Infinity(void) { return std::numeric_limits<uint64_t>::max(); }
+	static uint64_t Add(uint64_t a, uint64_t b) { return (a > Infinity() - b) ? Infinity() : a + b; } // stops at infinity instead of wrapping
+	static double ToCells(uint64_t cost) { return cost / 1000.0; }
+};
+
+template <>
+struct CostTraits<float> {
+	static float Straight(void) { return 1.0f; }
+	static float Diagonal(void) { return 1.41421356f; }
+	static float Infinity(void) { return std::numeric_limits<float>::infinity(); }
+	static float Add(float a, float b) { return a + b; }
+	static double ToCells(float cost) { return cost; }
+};
+
+template <>
+struct CostTraits<double> {
+	static double Straight(void) { return 1.0; }
+	static double Diagonal(void) { return 1.4142135623730951; }
+	static double Infinity(void) { return std::numeric_limits<double>::infinity(); }
+	static double Add(double a, double b) { return a + b; }
+	static double ToCells(double cost) { return cost; }
+};
+
+// manhattan distance, exact cost of the shortest 4 connected path without obstacles
+template <typename CostT>
+CostT ManhattanCost(int dx, int dy)
+{
+	if (dx < 0) dx = -dx;
+	if (dy < 0) dy = -dy;
+	return (CostT)(dx + dy) * CostTraits<CostT>::Straight();
+}
+
+// octile distance, exact cost of the shortest 8 connected path without obstacles
+template <typename CostT>
+CostT OctileCost(int dx, int dy)
+{
+	if (dx < 0) dx = -dx;
+	if (dy < 0) dy = -dy;
+	int diagonalSteps = std::min(dx, dy);
+	return (CostT)diagonalSteps * CostTraits<CostT>::Diagonal() + (CostT)(std::max(dx, dy) - diagonalSteps) * CostTraits<CostT>::Straight();
+}
+
+#endif
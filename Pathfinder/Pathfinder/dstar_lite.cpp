@@ -0,0 +1,247 @@
+/**
+  ******************************************************************************
+  * @file    dstar_lite.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the D* Lite planner, the
+  *          optimized version of Koenig and Likhachev. g is the cost to the
+  *          target of the expanded cells and rhs the best cost through their
+  *          neighbours, a cell is queued while the two values differ.
+  ******************************************************************************
+  */
+#include "dstar_lite.h"
+#include <algorithm>
+#include <cstdlib>
+
+DStarLite::DStarLite(const MapGrid& map) : _Map(map), _Obstacles(map.GetObstacleBitmap())
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	_SizeX = size.first;
+	_SizeY = size.second;
+	_NeighbourCount = map.GetNeighbourCount();
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		_DirX[dir] = offset.first;
+		_DirY[dir] = offset.second;
+		_StepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	size_t cellCount = (size_t)_SizeX * _SizeY;
+	_G.assign(cellCount, MapGrid::COST_INFINITY);
+	_Rhs.assign(cellCount, MapGrid::COST_INFINITY);
+	_PlanIds.assign(cellCount, 0);
+	_Open.Resize(cellCount);
+}
+
+bool DStarLite::Plan(GridPos startPos, GridPos targetPos)
+{
+	_ExpandedNodeCount = 0;
+	_PathFound = false;
+	if (_Obstacles.Test(startPos.first, startPos.second) || _Obstacles.Test(targetPos.first, targetPos.second)) return false;
+	uint32_t start = startPos.second * _SizeX + startPos.first;
+	uint32_t target = targetPos.second * _SizeX + targetPos.first;
+
+	if (!_HasTree || target != _Target || !_Map.GetChangedCells(_MapVersion, _Changed)) {
+		StartTree(start, target);
+	}
+	else {
+		// old keys were computed from the old start, they stay lower bounds if the modifier grows by the move
+		_Start = start;
+		if (start != _LastStart) {
+			_KeyModifier += Heuristic(_LastStart, start);
+			_LastStart = start;
+		}
+		// every edge whose cost changed ends at the changed cell or at one of its neighbours
+		for (uint32_t cell : _Changed) {
+			int cx = cell % _SizeX;
+			int cy = cell / _SizeX;
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dx = -1; dx <= 1; dx++) {
+					int x = cx + dx;
+					int y = cy + dy;
+					if ((unsigned)x >= (unsigned)_SizeX || (unsigned)y >= (unsigned)_SizeY) continue;
+					uint32_t idx = y * _SizeX + x;
+					if (idx == _Target) continue;
+					TouchCell(idx);
+					_Rhs[idx] = LookAhead(idx);
+					UpdateCell(idx);
+				}
+			}
+		}
+	}
+	_MapVersion = _Map.GetVersion();
+
+	ComputeShortestPath();
+	_PathFound = GetG(_Start) != MapGrid::COST_INFINITY;
+	return _PathFound;
+}
+
+void DStarLite::GetPath(std::vector<GridPos>& path) const
+{
+	path.clear();
+	if (!_PathFound) return;
+	// follow the best neighbour towards the target, a cell count guard keeps a broken tree from looping
+	uint32_t cell = _Start;
+	path.push_back(GridPos(cell % _SizeX, cell / _SizeX));
+	while (cell != _Target && path.size() <= _G.size()) {
+		int x = cell % _SizeX;
+		int y = cell / _SizeX;
+		uint64_t best = MapGrid::COST_INFINITY;
+		uint32_t next = cell;
+		for (int dir = 0; dir < _NeighbourCount; dir++) {
+			if (!IsEdge(x, y, dir)) continue;
+			uint32_t neighbour = (y + _DirY[dir]) * _SizeX + x + _DirX[dir];
+			Cost g = GetG(neighbour);
+			if (g == MapGrid::COST_INFINITY) continue;
+			uint64_t cost = (uint64_t)g + _StepCost[dir];
+			if (cost < best) {
+				best = cost;
+				next = neighbour;
+			}
+		}
+		if (next == cell) {
+			path.clear();
+			return;
+		}
+		cell = next;
+		path.push_back(GridPos(cell % _SizeX, cell / _SizeX));
+	}
+	if (cell != _Target) path.clear();
+}
+
+DStarLite::Cost DStarLite::GetPathCost(void) const
+{
+	return _PathFound ? GetG(_Start) : MapGrid::COST_INFINITY;
+}
+
+int DStarLite::GetExpandedNodeCount(void) const
+{
+	return _ExpandedNodeCount;
+}
+
+void DStarLite::Reset(void)
+{
+	_HasTree = false;
+	_PathFound = false;
+}
+
+void DStarLite::StartTree(uint32_t start, uint32_t target)
+{
+	// a new plan id invalidates the data of every cell at once
+	_PlanId++;
+	if (_PlanId == 0) {
+		std::fill(_PlanIds.begin(), _PlanIds.end(), 0);
+		_PlanId = 1;
+	}
+	_Open.Clear();
+	_Start = start;
+	_LastStart = start;
+	_Target = target;
+	_KeyModifier = 0;
+	_HasTree = true;
+	TouchCell(target);
+	_Rhs[target] = 0;
+	_Open.Push(target, CalculateKey(target));
+}
+
+void DStarLite::TouchCell(uint32_t cell)
+{
+	if (_PlanIds[cell] == _PlanId) return;
+	_PlanIds[cell] = _PlanId;
+	_G[cell] = MapGrid::COST_INFINITY;
+	_Rhs[cell] = MapGrid::COST_INFINITY;
+}
+
+// moves are symmetric, so an edge is usable in both directions when it is usable in one
+bool DStarLite::IsEdge(int x, int y, int dir) const
+{
+	return !_Obstacles.Test(x, y) && _Map.IsMoveAllowed(x, y, _DirX[dir], _DirY[dir]);
+}
+
+DStarLite::Cost DStarLite::Heuristic(uint32_t a, uint32_t b) const
+{
+	int dx = (int)(a % _SizeX) - (int)(b % _SizeX);
+	int dy = (int)(a / _SizeX) - (int)(b / _SizeX);
+	if (_NeighbourCount == 4) return ManhattanCost<Cost>(dx, dy);
+	return OctileCost<Cost>(dx, dy);
+}
+
+DStarLite::Key DStarLite::CalculateKey(uint32_t cell) const
+{
+	Cost best = std::min(GetG(cell), GetRhs(cell));
+	if (best == MapGrid::COST_INFINITY) return Key{ UINT64_MAX, UINT64_MAX };
+	return Key{ (uint64_t)best + Heuristic(_Start, cell) + _KeyModifier, best };
+}
+
+// best cost to the target through one of the neighbours
+DStarLite::Cost DStarLite::LookAhead(uint32_t cell) const
+{
+	int x = cell % _SizeX;
+	int y = cell / _SizeX;
+	uint64_t best = MapGrid::COST_INFINITY;
+	for (int dir = 0; dir < _NeighbourCount; dir++) {
+		if (!IsEdge(x, y, dir)) continue;
+		Cost g = GetG((y + _DirY[dir]) * _SizeX + x + _DirX[dir]);
+		if (g == MapGrid::COST_INFINITY) continue;
+		best = std::min(best, (uint64_t)g + _StepCost[dir]);
+	}
+	return (Cost)best;
+}
+
+// queues the cell if it is inconsistent, the cell must be touched
+void DStarLite::UpdateCell(uint32_t cell)
+{
+	bool queued = _Open.Contains(cell);
+	if (_G[cell] != _Rhs[cell]) {
+		if (queued) _Open.UpdateKey(cell, CalculateKey(cell));
+		else _Open.Push(cell, CalculateKey(cell));
+	}
+	else if (queued) {
+		_Open.Remove(cell);
+	}
+}
+
+void DStarLite::ComputeShortestPath(void)
+{
+	TouchCell(_Start);
+	while (!_Open.Empty() && (_Open.TopKey() < CalculateKey(_Start) || _Rhs[_Start] != _G[_Start])) {
+		uint32_t current = _Open.Top();
+		Key newKey = CalculateKey(current);
+		if (_Open.TopKey() < newKey) {
+			// queued before the start moved
+			_Open.UpdateKey(current, newKey);
+			continue;
+		}
+		_ExpandedNodeCount++;
+		int cx = current % _SizeX;
+		int cy = current / _SizeX;
+		if (_G[current] > _Rhs[current]) {
+			// cost went down, the neighbours may get cheaper through this cell
+			_G[current] = _Rhs[current];
+			_Open.Remove(current);
+			for (int dir = 0; dir < _NeighbourCount; dir++) {
+				if (!IsEdge(cx, cy, dir)) continue;
+				uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+				if (neighbour == _Target) continue;
+				TouchCell(neighbour);
+				uint64_t cost = (uint64_t)_G[current] + _StepCost[dir];
+				if (cost < _Rhs[neighbour]) _Rhs[neighbour] = (Cost)cost;
+				UpdateCell(neighbour);
+			}
+		}
+		else {
+			// cost went up, neighbours that used this cell look for a new one
+			uint64_t oldG = _G[current];
+			_G[current] = MapGrid::COST_INFINITY;
+			for (int dir = 0; dir < _NeighbourCount; dir++) {
+				if (!IsEdge(cx, cy, dir)) continue;
+				uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+				if (neighbour == _Target) continue;
+				TouchCell(neighbour);
+				if (_Rhs[neighbour] == oldG + _StepCost[dir]) _Rhs[neighbour] = LookAhead(neighbour);
+				UpdateCell(neighbour);
+			}
+			if (current != _Target) _Rhs[current] = LookAhead(current);
+			UpdateCell(current);
+		}
+	}
+}
@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file    dstar_lite.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the D* Lite planner. The search
+  *          runs from the target towards the start and its tree is kept between
+  *          plans. Obstacle changes of the map are read from the map's edit
+  *          history, only the cells around them are updated and the search
+  *          continues until the start is consistent again. A moving start only
+  *          raises the key modifier, the old keys stay valid lower bounds.
+  ******************************************************************************
+  */
+
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H
+
+#include <vector>
+#include <cstdint>
+#include "map_grid.h"
+#include "indexed_heap.h"
+
+class DStarLite {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::Cost Cost;
+
+	// the planner keeps a reference to the map, it must outlive the planner
+	DStarLite(const MapGrid& map);
+	// the first plan and plans to a new target search from scratch, later plans repair the tree
+	bool Plan(GridPos start, GridPos target); // true if a path is found
+	void GetPath(std::vector<GridPos>& path) const; // path of the last plan, start first, reuses the vector's storage
+	Cost GetPathCost(void) const; // cost of the last path or COST_INFINITY
+	int GetExpandedNodeCount(void) const; // nodes expanded by the last plan
+	void Reset(void); // the next plan starts from scratch
+
+private:
+	// keys are compared by the first value, the second one breaks ties
+	struct Key {
+		uint64_t primary;
+		uint64_t secondary;
+		bool operator<(const Key& other) const
+		{
+			return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+		}
+	};
+
+	const MapGrid& _Map;
+	const ObstacleBitmap& _Obstacles;
+	int _SizeX = 0;
+	int _SizeY = 0;
+	int _DirX[8];
+	int _DirY[8];
+	Cost _StepCost[8];
+	int _NeighbourCount = 4;
+
+	std::vector<Cost> _G; // cost to the target of the settled tree
+	std::vector<Cost> _Rhs; // one step look ahead of the cost to the target
+	std::vector<unsigned int> _PlanIds; // plan that last touched the cell, older values mean stale data
+	unsigned int _PlanId = 0;
+	IndexedHeap<Key> _Open; // locally inconsistent cells
+	std::vector<uint32_t> _Changed; // storage of the map's changed cells
+
+	bool _HasTree = false;
+	uint32_t _Start = 0;
+	uint32_t _Target = 0;
+	uint32_t _LastStart = 0; // start when the key modifier was last raised
+	uint64_t _KeyModifier = 0; // heuristic distance the start moved since the tree was started
+	uint64_t _MapVersion = 0;
+	bool _PathFound = false;
+	int _ExpandedNodeCount = 0;
+
+	void StartTree(uint32_t start, uint32_t target);
+	void TouchCell(uint32_t cell);
+	Cost GetG(uint32_t cell) const { return _PlanIds[cell] == _PlanId ? _G[cell] : MapGrid::COST_INFINITY; }
+	Cost GetRhs(uint32_t cell) const { return _PlanIds[cell] == _PlanId ? _Rhs[cell] : MapGrid::COST_INFINITY; }
+	bool IsEdge(int x, int y, int dir) const;
+	Cost Heuristic(uint32_t a, uint32_t b) const;
+	Key CalculateKey(uint32_t cell) const;
+	Cost LookAhead(uint32_t cell) const;
+	void UpdateCell(uint32_t cell);
+	void ComputeShortestPath(void);
+};
+
+#endif
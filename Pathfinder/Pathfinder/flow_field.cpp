@@ -0,0 +1,286 @@
+/**
+  ******************************************************************************
+  * @file    flow_field.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the flow field.
+  ******************************************************************************
+  */
+#include "flow_field.h"
+#include <algorithm>
+
+const uint8_t FlowField::NO_DIRECTION;
+
+// direction code of the move back, same order as the neighbour table of MapGrid
+static const uint8_t OPPOSITE_DIRECTION[8] = { 1, 0, 3, 2, 7, 6, 5, 4 };
+
+FlowField::FlowField(const MapGrid& map) : _Map(map), _Obstacles(map.GetObstacleBitmap())
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	_SizeX = size.first;
+	_SizeY = size.second;
+	_RowWords = _Obstacles.GetRowWordCount();
+	_NeighbourCount = map.GetNeighbourCount();
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		_DirX[dir] = offset.first;
+		_DirY[dir] = offset.second;
+		_StepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	_Open.Resize((size_t)_SizeX * _SizeY);
+}
+
+void FlowField::Build(GridPos target)
+{
+	_Target = target.second * _SizeX + target.first;
+	_MapVersion = _Map.GetVersion();
+	_Built = true;
+	_Distance.assign((size_t)_SizeX * _SizeY, MapGrid::COST_INFINITY);
+	_Direction.assign((size_t)_SizeX * _SizeY, NO_DIRECTION);
+	if (_Obstacles.Test(target.first, target.second)) return; // nothing reaches a blocked target
+
+	_Distance[_Target] = 0;
+	if (_NeighbourCount == 4) BuildWavefront();
+	else BuildDijkstra();
+}
+
+/**
+  * @brief  Breadth first search 64 cells at a time. Cells of the current wave are
+  *         kept in a bitmap, the words next to them are shifted towards each
+  *         other to find the free cells next to the wave that are not reached
+  *         yet. Only the words around the wave are visited.
+  */
+void FlowField::BuildWavefront(void)
+{
+	size_t wordCount = (size_t)_SizeY * _RowWords;
+	_Reached.assign(wordCount, 0);
+	_Front.assign(wordCount, 0);
+	_WordStamps.assign(wordCount, 0);
+	_Wave.clear();
+
+	int targetX = _Target % _SizeX;
+	int targetY = _Target / _SizeX;
+	FrontWord first = { (uint32_t)(targetY * _RowWords + (targetX >> 6)), 1ull << (targetX & 63) };
+	_Reached[first.word] = first.bits;
+	_Front[first.word] = first.bits;
+	_Wave.push_back(first);
+
+	Cost distance = 0;
+	for (uint32_t wave = 1; !_Wave.empty(); wave++) {
+		distance += MapGrid::COST_STRAIGHT;
+
+		// words the wave can spread into, each one once
+		_Touched.clear();
+		auto touch = [this, wave](uint32_t word) {
+			if (_WordStamps[word] == wave) return;
+			_WordStamps[word] = wave;
+			_Touched.push_back(word);
+		};
+		for (const FrontWord& front : _Wave) {
+			int y = front.word / _RowWords;
+			int w = front.word % _RowWords;
+			touch(front.word);
+			if (w > 0) touch(front.word - 1);
+			if (w + 1 < _RowWords) touch(front.word + 1);
+			if (y > 0) touch(front.word - _RowWords);
+			if (y + 1 < _SizeY) touch(front.word + _RowWords);
+		}
+
+		_NextWave.clear();
+		for (uint32_t word : _Touched) {
+			int y = word / _RowWords;
+			int w = word % _RowWords;
+			// bit x tells if the neighbour of cell x in that direction is in the wave
+			uint64_t front = _Front[word];
+			uint64_t fromLeft = (front << 1) | (w > 0 ? _Front[word - 1] >> 63 : 0);
+			uint64_t fromRight = (front >> 1) | (w + 1 < _RowWords ? _Front[word + 1] << 63 : 0);
+			uint64_t fromPrevRow = y > 0 ? _Front[word - _RowWords] : 0;
+			uint64_t fromNextRow = y + 1 < _SizeY ? _Front[word + _RowWords] : 0;
+			uint64_t fresh = (fromLeft | fromRight | fromPrevRow | fromNextRow) & ~_Obstacles.GetRowWord(y, w) & ~_Reached[word];
+			if (!fresh) continue;
+			_Reached[word] |= fresh;
+			_NextWave.push_back(FrontWord{ word, fresh });
+
+			uint32_t rowStart = y * _SizeX + (w << 6);
+			for (uint64_t bits = fresh; bits; bits &= bits - 1) {
+				int bit = CountTrailingZeros64(bits);
+				uint32_t cell = rowStart + bit;
+				_Distance[cell] = distance;
+				// first move goes to the neighbour in the wave, codes follow the map's direction table
+				if ((fromLeft >> bit) & 1) _Direction[cell] = 0;
+				else if ((fromRight >> bit) & 1) _Direction[cell] = 1;
+				else if ((fromPrevRow >> bit) & 1) _Direction[cell] = 2;
+				else _Direction[cell] = 3;
+			}
+		}
+
+		for (const FrontWord& front : _Wave) _Front[front.word] = 0;
+		for (const FrontWord& front : _NextWave) _Front[front.word] = front.bits;
+		_Wave.swap(_NextWave);
+	}
+}
+
+void FlowField::BuildDijkstra(void)
+{
+	_Open.Clear();
+	_Open.PushOrDecrease(_Target, 0, 0);
+	RunDijkstra();
+}
+
+void FlowField::RunDijkstra(void)
+{
+	while (!_Open.Empty()) {
+		uint32_t current = _Open.Pop();
+		int cx = current % _SizeX;
+		int cy = current / _SizeX;
+		Cost distance = _Distance[current];
+		// moves are symmetric, the neighbours reach the current cell with the opposite move
+		for (int dir = 0; dir < _NeighbourCount; dir++) {
+			if (!_Map.IsMoveAllowed(cx, cy, _DirX[dir], _DirY[dir])) continue;
+			uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+			Cost neighbourDistance = distance + _StepCost[dir];
+			if (neighbourDistance < _Distance[neighbour]) {
+				_Distance[neighbour] = neighbourDistance;
+				_Direction[neighbour] = OPPOSITE_DIRECTION[dir];
+				_Open.PushOrDecrease(neighbour, neighbourDistance, 0);
+			}
+		}
+	}
+}
+
+void FlowField::Update(void)
+{
+	if (!_Built || _Map.GetVersion() == _MapVersion) return;
+	GridPos target = GetTarget();
+	size_t cellCount = (size_t)_SizeX * _SizeY;
+	// a long edit history is cheaper to handle with a new field
+	if (!_Map.GetChangedCells(_MapVersion, _Changed) || _Changed.size() > cellCount / 256 ||
+		_Obstacles.Test(target.first, target.second)) {
+		Build(target);
+		return;
+	}
+	_MapVersion = _Map.GetVersion();
+
+	// cells whose move is not allowed anymore lose their cost, so do the cells that lead through them.
+	// Every move that changed starts at a changed cell or next to one
+	_Open.Clear();
+	_Invalid.clear();
+	for (uint32_t cell : _Changed) {
+		int cx = cell % _SizeX;
+		int cy = cell / _SizeX;
+		for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, _SizeY - 1); y++) {
+			for (int x = std::max(cx - 1, 0); x <= std::min(cx + 1, _SizeX - 1); x++) {
+				uint32_t idx = y * _SizeX + x;
+				if (_Direction[idx] != NO_DIRECTION && !FollowsField(idx)) InvalidateTree(idx);
+			}
+		}
+	}
+
+	// the cells without a cost and the cells that may have a new move take the best neighbour,
+	// the improved ones spread their cost with Dijkstra
+	for (uint32_t cell : _Invalid) {
+		if (Relax(cell)) _Open.PushOrDecrease(cell, _Distance[cell], 0);
+	}
+	for (uint32_t cell : _Changed) {
+		int cx = cell % _SizeX;
+		int cy = cell / _SizeX;
+		for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, _SizeY - 1); y++) {
+			for (int x = std::max(cx - 1, 0); x <= std::min(cx + 1, _SizeX - 1); x++) {
+				uint32_t idx = y * _SizeX + x;
+				if (Relax(idx)) _Open.PushOrDecrease(idx, _Distance[idx], 0);
+			}
+		}
+	}
+	RunDijkstra();
+}
+
+bool FlowField::Relax(uint32_t cell)
+{
+	int x = cell % _SizeX;
+	int y = cell / _SizeX;
+	if (cell == _Target || _Obstacles.Test(x, y)) return false;
+	Cost best = _Distance[cell];
+	int bestDir = -1;
+	for (int dir = 0; dir < _NeighbourCount; dir++) {
+		if (!_Map.IsMoveAllowed(x, y, _DirX[dir], _DirY[dir])) continue;
+		Cost distance = _Distance[(y + _DirY[dir]) * _SizeX + x + _DirX[dir]];
+		if (distance == MapGrid::COST_INFINITY) continue;
+		if (distance + _StepCost[dir] < best) {
+			best = distance + _StepCost[dir];
+			bestDir = dir;
+		}
+	}
+	if (bestDir < 0) return false;
+	_Distance[cell] = best;
+	_Direction[cell] = (uint8_t)bestDir;
+	return true;
+}
+
+// clears the cell and every cell whose moves lead through it
+void FlowField::InvalidateTree(uint32_t root)
+{
+	_Stack.clear();
+	_Stack.push_back(root);
+	_Distance[root] = MapGrid::COST_INFINITY;
+	_Direction[root] = NO_DIRECTION;
+	while (!_Stack.empty()) {
+		uint32_t cell = _Stack.back();
+		_Stack.pop_back();
+		_Invalid.push_back(cell);
+		int x = cell % _SizeX;
+		int y = cell / _SizeX;
+		for (int dir = 0; dir < _NeighbourCount; dir++) {
+			int nx = x + _DirX[dir];
+			int ny = y + _DirY[dir];
+			if ((unsigned)nx >= (unsigned)_SizeX || (unsigned)ny >= (unsigned)_SizeY) continue;
+			uint32_t neighbour = ny * _SizeX + nx;
+			if (_Direction[neighbour] != OPPOSITE_DIRECTION[dir]) continue;
+			_Distance[neighbour] = MapGrid::COST_INFINITY;
+			_Direction[neighbour] = NO_DIRECTION;
+			_Stack.push_back(neighbour);
+		}
+	}
+}
+
+bool FlowField::FollowsField(uint32_t cell) const
+{
+	int x = cell % _SizeX;
+	int y = cell / _SizeX;
+	int dir = _Direction[cell];
+	return !_Obstacles.Test(x, y) && _Map.IsMoveAllowed(x, y, _DirX[dir], _DirY[dir]);
+}
+
+MapGrid::GridPos FlowField::GetTarget(void) const
+{
+	return GridPos(_Target % _SizeX, _Target / _SizeX);
+}
+
+MapGrid::Cost FlowField::GetDistance(GridPos pos) const
+{
+	if (!_Built || (unsigned)pos.first >= (unsigned)_SizeX || (unsigned)pos.second >= (unsigned)_SizeY) return MapGrid::COST_INFINITY;
+	return _Distance[pos.second * _SizeX + pos.first];
+}
+
+int FlowField::GetDirection(GridPos pos) const
+{
+	if (!_Built || (unsigned)pos.first >= (unsigned)_SizeX || (unsigned)pos.second >= (unsigned)_SizeY) return NO_DIRECTION;
+	return _Direction[pos.second * _SizeX + pos.first];
+}
+
+bool FlowField::GetNextStep(GridPos pos, GridPos& next) const
+{
+	int dir = GetDirection(pos);
+	if (dir == NO_DIRECTION) return false;
+	next = GridPos(pos.first + _DirX[dir], pos.second + _DirY[dir]);
+	return true;
+}
+
+void FlowField::GetPath(GridPos start, std::vector<GridPos>& path) const
+{
+	path.clear();
+	if (GetDistance(start) == MapGrid::COST_INFINITY) return;
+	// every move lowers the cost, so the walk ends at the target
+	GridPos pos = start;
+	path.push_back(pos);
+	while (GetNextStep(pos, pos)) path.push_back(pos);
+}
@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file    flow_field.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the flow field. For a single
+  *          target it stores the cost to the target of every cell and the
+  *          direction of the first move towards it, so any number of agents
+  *          find their next step with one lookup. On 4 connected grids every
+  *          move costs the same and the field is built by a bit parallel
+  *          breadth first wavefront over the obstacle bitmap words, 8 connected
+  *          grids use Dijkstra with a bucket queue. Obstacle edits are read
+  *          from the map's edit history and only the cells behind them are
+  *          computed again.
+  ******************************************************************************
+  */
+
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <vector>
+#include <cstdint>
+#include "map_grid.h"
+#include "bucket_queue.h"
+
+class FlowField {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::Cost Cost;
+
+	static const uint8_t NO_DIRECTION = 0xFF; // target, blocked and unreachable cells
+
+	// the field keeps a reference to the map, it must outlive the field
+	FlowField(const MapGrid& map);
+	void Build(GridPos target); // whole field towards the target
+	// brings the field up to date with the obstacle edits since the last build or update.
+	// Builds the whole field again if the map's edit history does not go back that far
+	void Update(void);
+	bool IsBuilt(void) const { return _Built; }
+	GridPos GetTarget(void) const;
+
+	// per agent lookups, cells outside of the grid are unreachable
+	Cost GetDistance(GridPos pos) const; // COST_INFINITY if the target can not be reached
+	int GetDirection(GridPos pos) const; // direction code of MapGrid::GetDirectionOffset or NO_DIRECTION
+	bool GetNextStep(GridPos pos, GridPos& next) const; // false at the target and on unreachable cells
+	void GetPath(GridPos start, std::vector<GridPos>& path) const; // start first, empty if unreachable
+
+private:
+	const MapGrid& _Map;
+	const ObstacleBitmap& _Obstacles;
+	int _SizeX = 0;
+	int _SizeY = 0;
+	int _RowWords = 0;
+	int _DirX[8];
+	int _DirY[8];
+	Cost _StepCost[8];
+	int _NeighbourCount = 4;
+
+	bool _Built = false;
+	uint32_t _Target = 0;
+	uint64_t _MapVersion = 0;
+	std::vector<Cost> _Distance; // cost to the target of every cell
+	std::vector<uint8_t> _Direction; // first move towards the target of every cell
+
+	// wavefront data, one entry per bitmap word
+	struct FrontWord {
+		uint32_t word; // y * _RowWords + word index in the row
+		uint64_t bits;
+	};
+	std::vector<uint64_t> _Reached;
+	std::vector<uint64_t> _Front; // cells of the current wave
+	std::vector<uint32_t> _WordStamps; // wave that last queued the word
+	std::vector<FrontWord> _Wave;
+	std::vector<FrontWord> _NextWave;
+	std::vector<uint32_t> _Touched;
+
+	// update data
+	BucketQueue<Cost> _Open;
+	std::vector<uint32_t> _Changed;
+	std::vector<uint32_t> _Stack;
+	std::vector<uint32_t> _Invalid;
+
+	void BuildWavefront(void);
+	void BuildDijkstra(void);
+	void RunDijkstra(void);
+	bool Relax(uint32_t cell); // pulls the best cost from the neighbours, true if the cell improved
+	void InvalidateTree(uint32_t root);
+	bool FollowsField(uint32_t cell) const; // the stored move of the cell is still allowed
+};
+
+#endif
@@ -0,0 +1,485 @@
+/**
+  ******************************************************************************
+  * @file    hpa_star.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the hierarchical path
+  *          planner (HPA*).
+  ******************************************************************************
+  */
+#include "hpa_star.h"
+#include "parallel_for.h"
+#include <algorithm>
+
+const int HpaStar::ENTRANCE_SPLIT;
+
+static const uint32_t NO_CELL = 0xFFFFFFFFu;
+
+HpaStar::HpaStar(const MapGrid& map, int clusterSize) : _Map(map), _Obstacles(map.GetObstacleBitmap())
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	_SizeX = size.first;
+	_SizeY = size.second;
+	_ClusterSize = std::max(clusterSize, 2);
+	_ClustersX = (_SizeX + _ClusterSize - 1) / _ClusterSize;
+	_ClustersY = (_SizeY + _ClusterSize - 1) / _ClusterSize;
+	_NeighbourCount = map.GetNeighbourCount();
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		_DirX[dir] = offset.first;
+		_DirY[dir] = offset.second;
+		_StepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+
+	_Clusters.resize((size_t)_ClustersX * _ClustersY);
+	for (int cy = 0; cy < _ClustersY; cy++) {
+		for (int cx = 0; cx < _ClustersX; cx++) {
+			Cluster& cluster = _Clusters[cy * _ClustersX + cx];
+			cluster.x0 = cx * _ClusterSize;
+			cluster.y0 = cy * _ClusterSize;
+			cluster.width = std::min(_ClusterSize, _SizeX - cluster.x0);
+			cluster.height = std::min(_ClusterSize, _SizeY - cluster.y0);
+		}
+	}
+	_Dirty.assign(_Clusters.size(), 0);
+}
+
+void HpaStar::Build(int threadCount)
+{
+	_DirtyList.clear();
+	for (uint32_t cluster = 0; cluster < _Clusters.size(); cluster++) {
+		_Dirty[cluster] = 1;
+		_DirtyList.push_back(cluster);
+	}
+	_MapVersion = _Map.GetVersion();
+	RebuildClusters(threadCount);
+	_Built = true;
+}
+
+void HpaStar::Update(int threadCount)
+{
+	if (!_Built || !_Map.GetChangedCells(_MapVersion, _Changed)) {
+		Build(threadCount);
+		return;
+	}
+	if (_Changed.empty()) return;
+	_MapVersion = _Map.GetVersion();
+
+	// a changed cell on the edge of its cluster changes the entrances of the cluster next to it too
+	_DirtyList.clear();
+	for (uint32_t cell : _Changed) {
+		int x = cell % _SizeX;
+		int y = cell / _SizeX;
+		int cx = x / _ClusterSize;
+		int cy = y / _ClusterSize;
+		MarkDirty(cx, cy);
+		if (x % _ClusterSize == 0) MarkDirty(cx - 1, cy);
+		if (x % _ClusterSize == _ClusterSize - 1) MarkDirty(cx + 1, cy);
+		if (y % _ClusterSize == 0) MarkDirty(cx, cy - 1);
+		if (y % _ClusterSize == _ClusterSize - 1) MarkDirty(cx, cy + 1);
+	}
+	RebuildClusters(threadCount);
+}
+
+void HpaStar::MarkDirty(int clusterX, int clusterY)
+{
+	if (clusterX < 0 || clusterY < 0 || clusterX >= _ClustersX || clusterY >= _ClustersY) return;
+	uint32_t cluster = clusterY * _ClustersX + clusterX;
+	if (_Dirty[cluster]) return;
+	_Dirty[cluster] = 1;
+	_DirtyList.push_back(cluster);
+}
+
+void HpaStar::RebuildClusters(int threadCount)
+{
+	// every cluster only writes its own data, the borders are computed from both sides the same way
+	ParallelFor((int)_DirtyList.size(), threadCount, [this](int i) {
+		LocalSearch search;
+		BuildNodes(_DirtyList[i]);
+		BuildDistances(_DirtyList[i], search);
+	});
+
+	// links of the neighbours may point at nodes that moved inside a rebuilt cluster
+	std::vector<uint32_t> resolve;
+	for (uint32_t cluster : _DirtyList) {
+		int cx = cluster % _ClustersX;
+		int cy = cluster / _ClustersX;
+		resolve.push_back(cluster);
+		if (cx > 0 && !_Dirty[cluster - 1]) resolve.push_back(cluster - 1);
+		if (cx + 1 < _ClustersX && !_Dirty[cluster + 1]) resolve.push_back(cluster + 1);
+		if (cy > 0 && !_Dirty[cluster - _ClustersX]) resolve.push_back(cluster - _ClustersX);
+		if (cy + 1 < _ClustersY && !_Dirty[cluster + _ClustersX]) resolve.push_back(cluster + _ClustersX);
+	}
+	std::sort(resolve.begin(), resolve.end());
+	resolve.erase(std::unique(resolve.begin(), resolve.end()), resolve.end());
+	ParallelFor((int)resolve.size(), threadCount, [this, &resolve](int i) {
+		ResolveLinks(resolve[i]);
+	});
+
+	_RebuiltClusterCount = (int)_DirtyList.size();
+	for (uint32_t cluster : _DirtyList) _Dirty[cluster] = 0;
+	_DirtyList.clear();
+	NumberNodes();
+}
+
+/**
+  * @brief  Finds the transitions across the border to the next cluster column
+  *         (or row). Both cells of a pair must be free, a run shorter than
+  *         ENTRANCE_SPLIT gets one transition in its middle, a longer one
+  *         gets one at each end.
+  * @retval pairs of (cell in this cluster, cell in the next cluster)
+  */
+void HpaStar::BorderTransitions(int clusterX, int clusterY, bool nextColumn, Transitions& transitions) const
+{
+	transitions.clear();
+	if (nextColumn ? (clusterX + 1 >= _ClustersX) : (clusterY + 1 >= _ClustersY)) return;
+	const Cluster& cluster = _Clusters[clusterY * _ClustersX + clusterX];
+	int length = nextColumn ? cluster.height : cluster.width;
+	auto cellPair = [&](int i) {
+		int x = nextColumn ? cluster.x0 + cluster.width - 1 : cluster.x0 + i;
+		int y = nextColumn ? cluster.y0 + i : cluster.y0 + cluster.height - 1;
+		uint32_t cell = y * _SizeX + x;
+		return std::make_pair(cell, nextColumn ? cell + 1 : cell + _SizeX);
+	};
+	auto isOpen = [&](int i) {
+		int x = nextColumn ? cluster.x0 + cluster.width - 1 : cluster.x0 + i;
+		int y = nextColumn ? cluster.y0 + i : cluster.y0 + cluster.height - 1;
+		return !_Obstacles.Test(x, y) && !_Obstacles.Test(x + (nextColumn ? 1 : 0), y + (nextColumn ? 0 : 1));
+	};
+
+	int runStart = -1;
+	for (int i = 0; i <= length; i++) {
+		bool open = i < length && isOpen(i);
+		if (open && runStart < 0) runStart = i;
+		if (open || runStart < 0) continue;
+		int runLength = i - runStart;
+		if (runLength < ENTRANCE_SPLIT) {
+			transitions.push_back(cellPair(runStart + runLength / 2));
+		}
+		else {
+			transitions.push_back(cellPair(runStart));
+			transitions.push_back(cellPair(i - 1));
+		}
+		runStart = -1;
+	}
+}
+
+void HpaStar::BuildNodes(uint32_t clusterIdx)
+{
+	Cluster& cluster = _Clusters[clusterIdx];
+	int cx = clusterIdx % _ClustersX;
+	int cy = clusterIdx / _ClustersX;
+	cluster.nodes.clear();
+	cluster.links.clear();
+
+	// borders to the left and above belong to the previous cluster, their pairs are swapped
+	Transitions transitions;
+	for (int side = 0; side < 4; side++) {
+		bool swapped = side >= 2;
+		if (side == 0) BorderTransitions(cx, cy, true, transitions);
+		else if (side == 1) BorderTransitions(cx, cy, false, transitions);
+		else if (side == 2 && cx > 0) BorderTransitions(cx - 1, cy, true, transitions);
+		else if (side == 3 && cy > 0) BorderTransitions(cx, cy - 1, false, transitions);
+		else transitions.clear();
+
+		for (const std::pair<uint32_t, uint32_t>& transition : transitions) {
+			uint32_t cell = swapped ? transition.second : transition.first;
+			uint32_t otherCell = swapped ? transition.first : transition.second;
+			// corner cells can be on two borders
+			uint32_t node = (uint32_t)(std::find(cluster.nodes.begin(), cluster.nodes.end(), cell) - cluster.nodes.begin());
+			if (node == cluster.nodes.size()) cluster.nodes.push_back(cell);
+			cluster.links.push_back(Link{ node, otherCell, 0, 0 });
+		}
+	}
+
+	std::sort(cluster.links.begin(), cluster.links.end(), [](const Link& a, const Link& b) {
+		return a.node < b.node || (a.node == b.node && a.otherCell < b.otherCell);
+	});
+	cluster.linkBegin.assign(cluster.nodes.size() + 1, 0);
+	for (const Link& link : cluster.links) cluster.linkBegin[link.node + 1]++;
+	for (size_t node = 0; node < cluster.nodes.size(); node++) cluster.linkBegin[node + 1] += cluster.linkBegin[node];
+}
+
+// shortest distances between the nodes of a cluster, moves stay inside the cluster
+void HpaStar::BuildDistances(uint32_t clusterIdx, LocalSearch& search)
+{
+	Cluster& cluster = _Clusters[clusterIdx];
+	size_t nodeCount = cluster.nodes.size();
+	cluster.distances.assign(nodeCount * nodeCount, MapGrid::COST_INFINITY);
+	ResetMoves(search);
+	for (size_t i = 0; i < nodeCount; i++) {
+		cluster.distances[i * nodeCount + i] = 0;
+		if (i + 1 == nodeCount) break;
+		SearchCluster(search, clusterIdx, cluster.nodes[i], NO_CELL);
+		for (size_t j = i + 1; j < nodeCount; j++) {
+			Cost cost = LocalCost(search, clusterIdx, cluster.nodes[j]);
+			cluster.distances[i * nodeCount + j] = cost;
+			cluster.distances[j * nodeCount + i] = cost;
+		}
+	}
+}
+
+void HpaStar::ResolveLinks(uint32_t clusterIdx)
+{
+	for (Link& link : _Clusters[clusterIdx].links) {
+		link.otherCluster = ClusterOf(link.otherCell);
+		const std::vector<uint32_t>& nodes = _Clusters[link.otherCluster].nodes;
+		link.otherNode = (uint32_t)(std::find(nodes.begin(), nodes.end(), link.otherCell) - nodes.begin());
+	}
+}
+
+void HpaStar::NumberNodes(void)
+{
+	_NodeOffset.resize(_Clusters.size() + 1);
+	_NodeOffset[0] = 0;
+	for (size_t cluster = 0; cluster < _Clusters.size(); cluster++) {
+		_NodeOffset[cluster + 1] = _NodeOffset[cluster] + (uint32_t)_Clusters[cluster].nodes.size();
+	}
+	_NodeCount = _NodeOffset.back();
+	_NodeCluster.resize(_NodeCount);
+	for (size_t cluster = 0; cluster < _Clusters.size(); cluster++) {
+		std::fill(_NodeCluster.begin() + _NodeOffset[cluster], _NodeCluster.begin() + _NodeOffset[cluster + 1], (uint32_t)cluster);
+	}
+}
+
+/**
+  * @brief  A* inside one cluster from source to goal, or Dijkstra to every cell of
+  *         the cluster if goal is NO_CELL. ResetMoves must be called when
+  *         the cluster changes. Costs and parents are left in search.
+  */
+void HpaStar::SearchCluster(LocalSearch& search, uint32_t clusterIdx, uint32_t source, uint32_t goal) const
+{
+	const Cluster& cluster = _Clusters[clusterIdx];
+	size_t cellCount = (size_t)_ClusterSize * _ClusterSize;
+	if (search.searchIds.size() != cellCount) {
+		search.cost.assign(cellCount, MapGrid::COST_INFINITY);
+		search.parent.assign(cellCount, NO_CELL);
+		search.searchIds.assign(cellCount, 0);
+		search.open.Resize(cellCount);
+		search.searchId = 0;
+	}
+	search.open.Clear();
+	search.searchId++;
+	if (search.searchId == 0) {
+		std::fill(search.searchIds.begin(), search.searchIds.end(), 0);
+		search.searchId = 1;
+	}
+
+	auto localIndex = [&cluster](int x, int y) { return (uint32_t)((y - cluster.y0) * cluster.width + (x - cluster.x0)); };
+	int sourceX = source % _SizeX;
+	int sourceY = source / _SizeX;
+	uint32_t sourceLocal = localIndex(sourceX, sourceY);
+	search.searchIds[sourceLocal] = search.searchId;
+	search.cost[sourceLocal] = 0;
+	search.parent[sourceLocal] = NO_CELL;
+	search.open.Push(sourceLocal, goal == NO_CELL ? 0 : Heuristic(source, goal));
+	uint32_t goalLocal = (goal == NO_CELL) ? NO_CELL : localIndex(goal % _SizeX, goal / _SizeX);
+	int offsets[8];
+	for (int dir = 0; dir < _NeighbourCount; dir++) offsets[dir] = _DirY[dir] * cluster.width + _DirX[dir];
+
+	while (!search.open.Empty()) {
+		uint32_t current = search.open.Pop();
+		if (current == goalLocal) break;
+		for (uint32_t moves = CellMoves(search, cluster, current); moves; moves &= moves - 1) {
+			int dir = CountTrailingZeros64(moves);
+			uint32_t neighbour = current + offsets[dir];
+			if (search.searchIds[neighbour] != search.searchId) {
+				search.searchIds[neighbour] = search.searchId;
+				search.cost[neighbour] = MapGrid::COST_INFINITY;
+			}
+			Cost cost = search.cost[current] + _StepCost[dir];
+			if (cost < search.cost[neighbour]) {
+				search.cost[neighbour] = cost;
+				search.parent[neighbour] = current;
+				Cost estimate = 0;
+				if (goal != NO_CELL) {
+					int nx = cluster.x0 + (int)(neighbour % cluster.width);
+					int ny = cluster.y0 + (int)(neighbour / cluster.width);
+					estimate = Heuristic(ny * _SizeX + nx, goal);
+				}
+				search.open.PushOrDecrease(neighbour, cost + estimate);
+			}
+		}
+	}
+}
+
+// forgets the moves of the last cluster, cells load their moves the first time a search reaches them
+void HpaStar::ResetMoves(LocalSearch& search) const
+{
+	size_t cellCount = (size_t)_ClusterSize * _ClusterSize;
+	if (search.moveIds.size() != cellCount) {
+		search.moves.assign(cellCount, 0);
+		search.moveIds.assign(cellCount, 0);
+		search.moveId = 0;
+	}
+	search.moveId++;
+	if (search.moveId == 0) {
+		std::fill(search.moveIds.begin(), search.moveIds.end(), 0);
+		search.moveId = 1;
+	}
+}
+
+// allowed moves of a cell that stay inside the cluster, one bit per direction code
+uint32_t HpaStar::CellMoves(LocalSearch& search, const Cluster& cluster, uint32_t local) const
+{
+	if (search.moveIds[local] == search.moveId) return search.moves[local];
+	int x = (int)(local % cluster.width);
+	int y = (int)(local / cluster.width);
+	uint8_t moves = 0;
+	for (int dir = 0; dir < _NeighbourCount; dir++) {
+		int nx = x + _DirX[dir];
+		int ny = y + _DirY[dir];
+		if (nx < 0 || ny < 0 || nx >= cluster.width || ny >= cluster.height) continue;
+		if (_Map.IsMoveAllowed(cluster.x0 + x, cluster.y0 + y, _DirX[dir], _DirY[dir])) moves |= (uint8_t)(1 << dir);
+	}
+	search.moveIds[local] = search.moveId;
+	search.moves[local] = moves;
+	return moves;
+}
+
+MapGrid::Cost HpaStar::LocalCost(const LocalSearch& search, uint32_t clusterIdx, uint32_t cell) const
+{
+	const Cluster& cluster = _Clusters[clusterIdx];
+	uint32_t local = (cell / _SizeX - cluster.y0) * cluster.width + (cell % _SizeX - cluster.x0);
+	return search.searchIds[local] == search.searchId ? search.cost[local] : MapGrid::COST_INFINITY;
+}
+
+MapGrid::Cost HpaStar::Heuristic(uint32_t a, uint32_t b) const
+{
+	int dx = (int)(a % _SizeX) - (int)(b % _SizeX);
+	int dy = (int)(a / _SizeX) - (int)(b / _SizeX);
+	if (_NeighbourCount == 4) return ManhattanCost<Cost>(dx, dy);
+	return OctileCost<Cost>(dx, dy);
+}
+
+bool HpaStar::FindAbstractPath(GridPos startPos, GridPos targetPos)
+{
+	Update();
+	_PathCells.clear();
+	_PathCost = MapGrid::COST_INFINITY;
+	_Abstract.BeginSearch(_NodeCount + 2);
+	if (_Obstacles.Test(startPos.first, startPos.second) || _Obstacles.Test(targetPos.first, targetPos.second)) return false;
+	uint32_t start = startPos.second * _SizeX + startPos.first;
+	uint32_t target = targetPos.second * _SizeX + targetPos.first;
+	uint32_t startCluster = ClusterOf(start);
+	uint32_t targetCluster = ClusterOf(target);
+
+	// the start and the target join the graph through the nodes of their clusters
+	const Cluster& first = _Clusters[startCluster];
+	const Cluster& last = _Clusters[targetCluster];
+	ResetMoves(_Local);
+	SearchCluster(_Local, startCluster, start, NO_CELL);
+	_StartEdges.resize(first.nodes.size());
+	for (size_t i = 0; i < first.nodes.size(); i++) _StartEdges[i] = LocalCost(_Local, startCluster, first.nodes[i]);
+	Cost direct = (startCluster == targetCluster) ? LocalCost(_Local, startCluster, target) : MapGrid::COST_INFINITY;
+	ResetMoves(_Local);
+	SearchCluster(_Local, targetCluster, target, NO_CELL);
+	_TargetEdges.resize(last.nodes.size());
+	for (size_t i = 0; i < last.nodes.size(); i++) _TargetEdges[i] = LocalCost(_Local, targetCluster, last.nodes[i]);
+
+	SearchContext<Cost>& context = _Abstract;
+	const uint32_t startNode = _NodeCount;
+	const uint32_t targetNode = _NodeCount + 1;
+	context.start = startNode;
+	context.target = targetNode;
+	context.TouchCell(startNode);
+	context.localGoal[startNode] = 0;
+	context.OpenCell(startNode, Heuristic(start, target));
+
+	uint32_t current = startNode;
+	auto relax = [&](uint32_t node, Cost edge, uint32_t cell) {
+		if (context.IsCellVisited(node)) return;
+		context.TouchCell(node);
+		Cost localGoal = context.localGoal[current] + edge;
+		if (localGoal < context.localGoal[node]) {
+			context.parent[node] = current;
+			context.localGoal[node] = localGoal;
+			context.OpenCell(node, localGoal + Heuristic(cell, target));
+		}
+	};
+
+	while (!context.openList.Empty()) {
+		current = context.openList.Pop();
+		context.MarkVisited(current);
+		if (current == targetNode) break;
+
+		if (current == startNode) {
+			for (size_t i = 0; i < first.nodes.size(); i++) {
+				if (_StartEdges[i] != MapGrid::COST_INFINITY) relax(_NodeOffset[startCluster] + (uint32_t)i, _StartEdges[i], first.nodes[i]);
+			}
+			if (direct != MapGrid::COST_INFINITY) relax(targetNode, direct, target);
+			continue;
+		}
+
+		uint32_t clusterIdx = _NodeCluster[current];
+		const Cluster& cluster = _Clusters[clusterIdx];
+		uint32_t node = current - _NodeOffset[clusterIdx];
+		size_t nodeCount = cluster.nodes.size();
+		for (size_t j = 0; j < nodeCount; j++) {
+			Cost distance = cluster.distances[node * nodeCount + j];
+			if (j != node && distance != MapGrid::COST_INFINITY) relax(_NodeOffset[clusterIdx] + (uint32_t)j, distance, cluster.nodes[j]);
+		}
+		for (uint32_t k = cluster.linkBegin[node]; k < cluster.linkBegin[node + 1]; k++) {
+			const Link& link = cluster.links[k];
+			relax(_NodeOffset[link.otherCluster] + link.otherNode, MapGrid::COST_STRAIGHT, link.otherCell);
+		}
+		if (clusterIdx == targetCluster && _TargetEdges[node] != MapGrid::COST_INFINITY) relax(targetNode, _TargetEdges[node], target);
+	}
+	if (!context.IsCellVisited(targetNode)) return false;
+
+	_PathCost = context.localGoal[targetNode];
+	for (uint32_t node = targetNode; node != SearchContext<Cost>::NO_PARENT; node = context.parent[node]) {
+		if (node == targetNode) _PathCells.push_back(target);
+		else if (node == startNode) _PathCells.push_back(start);
+		else _PathCells.push_back(_Clusters[_NodeCluster[node]].nodes[node - _NodeOffset[_NodeCluster[node]]]);
+	}
+	std::reverse(_PathCells.begin(), _PathCells.end());
+	return true;
+}
+
+size_t HpaStar::GetSegmentCount(void) const
+{
+	return _PathCells.empty() ? 0 : _PathCells.size() - 1;
+}
+
+void HpaStar::RefineSegment(size_t segment, std::vector<GridPos>& path)
+{
+	uint32_t from = _PathCells[segment];
+	uint32_t to = _PathCells[segment + 1];
+	if (from == to) return; // the start or the target is on a node
+	uint32_t clusterIdx = ClusterOf(from);
+	if (clusterIdx != ClusterOf(to)) {
+		// transitions are single straight moves
+		path.push_back(GridPos(to % _SizeX, to / _SizeX));
+		return;
+	}
+
+	ResetMoves(_Local);
+	SearchCluster(_Local, clusterIdx, from, to);
+	const Cluster& cluster = _Clusters[clusterIdx];
+	size_t first = path.size();
+	uint32_t fromLocal = (from / _SizeX - cluster.y0) * cluster.width + (from % _SizeX - cluster.x0);
+	for (uint32_t local = (to / _SizeX - cluster.y0) * cluster.width + (to % _SizeX - cluster.x0); local != fromLocal; local = _Local.parent[local]) {
+		path.push_back(GridPos(cluster.x0 + (int)(local % cluster.width), cluster.y0 + (int)(local / cluster.width)));
+	}
+	std::reverse(path.begin() + first, path.end());
+}
+
+bool HpaStar::FindPath(GridPos start, GridPos target, std::vector<GridPos>& path)
+{
+	path.clear();
+	if (!FindAbstractPath(start, target)) return false;
+	path.push_back(start);
+	for (size_t segment = 0; segment < GetSegmentCount(); segment++) RefineSegment(segment, path);
+	return true;
+}
+
+MapGrid::Cost HpaStar::GetPathCost(void) const
+{
+	return _PathCost;
+}
+
+int HpaStar::GetExpandedNodeCount(void) const
+{
+	return _Abstract.expandedNodeCount;
+}
@@ -0,0 +1,135 @@
+/**
+  ******************************************************************************
+  * @file    hpa_star.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the hierarchical path planner
+  *          (HPA*). The grid is cut into square clusters, a maximal run of free
+  *          cell pairs across the border of two clusters is an entrance with one
+  *          transition in its middle, or one at each end when it is long. The
+  *          cells of the transitions are the nodes of the abstract graph, nodes
+  *          of one cluster are joined by their shortest distance inside the
+  *          cluster. Queries search the abstract graph and each segment of the
+  *          abstract path can be refined on its own with a search inside one
+  *          cluster. Paths are close to the shortest, not always the shortest.
+  *          Obstacle edits only make the clusters around them dirty, the dirty
+  *          clusters are rebuilt in parallel.
+  ******************************************************************************
+  */
+
+#ifndef HPA_STAR_H
+#define HPA_STAR_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "map_grid.h"
+#include "indexed_heap.h"
+#include "search_context.h"
+
+class HpaStar {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::Cost Cost;
+
+	static const int ENTRANCE_SPLIT = 6; // entrances at least this long get two transitions
+
+	// the planner keeps a reference to the map, it must outlive the planner
+	HpaStar(const MapGrid& map, int clusterSize = 32);
+	void Build(int threadCount = 0); // every cluster, 0 threads means all cores
+	// rebuilds the clusters touched by the obstacle edits since the last build or update,
+	// builds everything if the map's edit history does not go back that far
+	void Update(int threadCount = 0);
+
+	// searches the abstract graph, brings the graph up to date first. True if a path is found
+	bool FindAbstractPath(GridPos start, GridPos target);
+	size_t GetSegmentCount(void) const; // segments of the last abstract path
+	// appends the cells of one segment to path without its first cell, segments can be refined in any order
+	void RefineSegment(size_t segment, std::vector<GridPos>& path);
+	// abstract search and refinement of every segment, start first
+	bool FindPath(GridPos start, GridPos target, std::vector<GridPos>& path);
+	Cost GetPathCost(void) const; // cost of the last abstract path or COST_INFINITY
+
+	int GetClusterCount(void) const { return (int)_Clusters.size(); }
+	int GetNodeCount(void) const { return (int)_NodeCount; }
+	int GetExpandedNodeCount(void) const; // abstract nodes expanded by the last search
+	int GetRebuiltClusterCount(void) const { return _RebuiltClusterCount; } // by the last build or update
+
+private:
+	// transition to a node of a neighbour cluster
+	struct Link {
+		uint32_t node; // local node of this cluster
+		uint32_t otherCell;
+		uint32_t otherCluster;
+		uint32_t otherNode;
+	};
+
+	struct Cluster {
+		int x0, y0, width, height;
+		std::vector<uint32_t> nodes; // cell of each node
+		std::vector<Cost> distances; // nodes x nodes, COST_INFINITY if not connected inside the cluster
+		std::vector<Link> links; // sorted by local node
+		std::vector<uint32_t> linkBegin; // first link of each node, one more entry than nodes
+	};
+
+	// search data of the searches inside one cluster, local cell indices
+	struct LocalSearch {
+		std::vector<Cost> cost;
+		std::vector<uint32_t> parent;
+		std::vector<unsigned int> searchIds;
+		unsigned int searchId = 0;
+		IndexedHeap<Cost> open;
+		std::vector<uint8_t> moves; // allowed moves of each cell, see CellMoves
+		std::vector<unsigned int> moveIds;
+		unsigned int moveId = 0;
+	};
+
+	typedef std::vector<std::pair<uint32_t, uint32_t>> Transitions;
+
+	const MapGrid& _Map;
+	const ObstacleBitmap& _Obstacles;
+	int _SizeX = 0;
+	int _SizeY = 0;
+	int _ClusterSize = 32;
+	int _ClustersX = 0;
+	int _ClustersY = 0;
+	int _DirX[8];
+	int _DirY[8];
+	Cost _StepCost[8];
+	int _NeighbourCount = 4;
+
+	bool _Built = false;
+	uint64_t _MapVersion = 0;
+	std::vector<Cluster> _Clusters;
+	std::vector<uint32_t> _NodeOffset; // global id of the first node of each cluster
+	std::vector<uint32_t> _NodeCluster; // cluster of each global node id
+	uint32_t _NodeCount = 0;
+	int _RebuiltClusterCount = 0;
+	std::vector<uint8_t> _Dirty;
+	std::vector<uint32_t> _DirtyList;
+	std::vector<uint32_t> _Changed;
+
+	// query data, the start and the target are the two nodes after the graph nodes
+	SearchContext<Cost> _Abstract;
+	LocalSearch _Local;
+	std::vector<Cost> _StartEdges;
+	std::vector<Cost> _TargetEdges;
+	std::vector<uint32_t> _PathCells; // cells of the last abstract path
+	Cost _PathCost = MapGrid::COST_INFINITY;
+
+	uint32_t ClusterOf(uint32_t cell) const { return ((cell / _SizeX) / _ClusterSize) * _ClustersX + (cell % _SizeX) / _ClusterSize; }
+	void MarkDirty(int clusterX, int clusterY);
+	void RebuildClusters(int threadCount);
+	void BorderTransitions(int clusterX, int clusterY, bool nextColumn, Transitions& transitions) const;
+	void BuildNodes(uint32_t cluster);
+	void BuildDistances(uint32_t cluster, LocalSearch& search);
+	void ResolveLinks(uint32_t cluster);
+	void NumberNodes(void);
+	void ResetMoves(LocalSearch& search) const;
+	uint32_t CellMoves(LocalSearch& search, const Cluster& cluster, uint32_t local) const;
+	void SearchCluster(LocalSearch& search, uint32_t cluster, uint32_t source, uint32_t goal) const;
+	Cost LocalCost(const LocalSearch& search, uint32_t cluster, uint32_t cell) const;
+	Cost Heuristic(uint32_t a, uint32_t b) const;
+};
+
+#endif
@@ -0,0 +1,166 @@
+/**
+  ******************************************************************************
+  * @file    indexed_heap.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the indexed binary min-heap used as the open list
+  *          of the grid searches. Every item is a cell index, the heap keeps a
+  *          position table so an item can be found and its key decreased in
+  *          O(log n) without pushing duplicates.
+  ******************************************************************************
+  */
+
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+template <typename KeyT>
+class IndexedHeap {
+public:
+	static const uint32_t NOT_IN_HEAP = 0xFFFFFFFFu;
+
+	IndexedHeap(size_t capacity = 0)
+	{
+		Resize(capacity);
+	}
+
+	// capacity is the number of different item ids (e.g. number of grid cells)
+	void Resize(size_t capacity)
+	{
+		_Heap.clear();
+		_Heap.reserve(capacity);
+		_Position.assign(capacity, NOT_IN_HEAP);
+	}
+
+	// only the items that are still in the heap are touched, so clearing is cheap
+	void Clear()
+	{
+		for (const Entry& e : _Heap) {
+			_Position[e.id] = NOT_IN_HEAP;
+		}
+		_Heap.clear();
+	}
+
+	bool Empty() const { return _Heap.empty(); }
+	size_t Size() const { return _Heap.size(); }
+	bool Contains(uint32_t id) const { return _Position[id] != NOT_IN_HEAP; }
+	uint32_t Top() const { return _Heap.front().id; }
+	KeyT TopKey() const { return _Heap.front().key; }
+
+	void Push(uint32_t id, KeyT key)
+	{
+		_Position[id] = (uint32_t)_Heap.size();
+		_Heap.push_back(Entry{ key, id });
+		SiftUp(_Heap.size() - 1);
+	}
+
+	// new key must not be greater than the current key of the item
+	void DecreaseKey(uint32_t id, KeyT key)
+	{
+		size_t pos = _Position[id];
+		_Heap[pos].key = key;
+		SiftUp(pos);
+	}
+
+	void PushOrDecrease(uint32_t id, KeyT key)
+	{
+		if (Contains(id)) DecreaseKey(id, key);
+		else Push(id, key);
+	}
+
+	// key of the item may move in either direction
+	void UpdateKey(uint32_t id, KeyT key)
+	{
+		size_t pos = _Position[id];
+		bool decreased = key < _Heap[pos].key;
+		_Heap[pos].key = key;
+		if (decreased) SiftUp(pos);
+		else SiftDown(pos);
+	}
+
+	void Remove(uint32_t id)
+	{
+		size_t pos = _Position[id];
+		_Position[id] = NOT_IN_HEAP;
+		Entry last = _Heap.back();
+		_Heap.pop_back();
+		if (pos == _Heap.size()) return; // removed the last entry
+		bool decreased = last.key < _Heap[pos].key;
+		_Heap[pos] = last;
+		_Position[last.id] = (uint32_t)pos;
+		if (decreased) SiftUp(pos);
+		else SiftDown(pos);
+	}
+
+	// recomputes every key with keyOf(id) and restores the heap order in O(n)
+	template <typename KeyFunc>
+	void Rekey(KeyFunc keyOf)
+	{
+		for (Entry& e : _Heap) e.key = keyOf(e.id);
+		for (size_t pos = _Heap.size() / 2; pos > 0; pos--) SiftDown(pos - 1);
+	}
+
+	uint32_t Pop()
+	{
+		uint32_t topId = _Heap.front().id;
+		_Position[topId] = NOT_IN_HEAP;
+		if (_Heap.size() > 1) {
+			_Heap.front() = _Heap.back();
+			_Position[_Heap.front().id] = 0;
+			_Heap.pop_back();
+			SiftDown(0);
+		}
+		else {
+			_Heap.pop_back();
+		}
+		return topId;
+	}
+
+private:
+	struct Entry {
+		KeyT key;
+		uint32_t id;
+	};
+
+	std::vector<Entry> _Heap;
+	std::vector<uint32_t> _Position; // index of each item inside _Heap or NOT_IN_HEAP
+
+	void SiftUp(size_t pos)
+	{
+		Entry item = _Heap[pos];
+		while (pos > 0) {
+			size_t parent = (pos - 1) / 2;
+			if (!(item.key < _Heap[parent].key)) break;
+			_Heap[pos] = _Heap[parent];
+			_Position[_Heap[pos].id] = (uint32_t)pos;
+			pos = parent;
+		}
+		_Heap[pos] = item;
+		_Position[item.id] = (uint32_t)pos;
+	}
+
+	void SiftDown(size_t pos)
+	{
+		Entry item = _Heap[pos];
+		size_t count = _Heap.size();
+		while (true) {
+			size_t child = 2 * pos + 1;
+			if (child >= count) break;
+			if (child + 1 < count && _Heap[child + 1].key < _Heap[child].key) child++;
+			if (!(_Heap[child].key < item.key)) break;
+			_Heap[pos] = _Heap[child];
+			_Position[_Heap[pos].id] = (uint32_t)pos;
+			pos = child;
+		}
+		_Heap[pos] = item;
+		_Position[item.id] = (uint32_t)pos;
+	}
+};
+
+template <typename KeyT>
+const uint32_t IndexedHeap<KeyT>::NOT_IN_HEAP;
+
+#endif
@@ -0,0 +1,181 @@
+/**
+  ******************************************************************************
+  * @file    jps_plus.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the JPS+ jump distance table.
+  *          Every entry is derived from the next cell in the same direction, so
+  *          rows, columns and diagonal lines are swept from their far end.
+  ******************************************************************************
+  */
+#include "jps_plus.h"
+#include "parallel_for.h"
+#include <algorithm>
+
+static const int DIAGONALS[4][2] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+static const int LINE_BLOCK = 16; // lines per parallel work item
+
+const int JpsPlusTable::MAX_SIZE;
+
+static inline int16_t ContinueJump(int next)
+{
+	// keep counting towards the jump point or the wall found by the next cell
+	return (int16_t)(next > 0 ? next + 1 : next - 1);
+}
+
+void JpsPlusTable::Clear(void)
+{
+	_Distances.clear();
+	_Distances.shrink_to_fit();
+}
+
+void JpsPlusTable::Build(const ObstacleBitmap& bitmap, int threadCount)
+{
+	// a jump along a longer line would wrap around in ContinueJump
+	if (bitmap.GetSizeX() > MAX_SIZE || bitmap.GetSizeY() > MAX_SIZE) {
+		Clear();
+		return;
+	}
+	_SizeX = bitmap.GetSizeX();
+	_SizeY = bitmap.GetSizeY();
+	_Distances.assign((size_t)_SizeX * _SizeY * 8, 0);
+
+	// straight jumps only depend on their own line and the two side lines. Columns and
+	// diagonal lines are handed out in blocks of neighbouring lines, so threads do not
+	// write into the same cache lines
+	ParallelFor(_SizeY, threadCount, [&](int y) { BuildRow(bitmap, y); });
+	ParallelFor((_SizeX + LINE_BLOCK - 1) / LINE_BLOCK, threadCount, [&](int block) {
+		for (int x = block * LINE_BLOCK; x < std::min(_SizeX, (block + 1) * LINE_BLOCK); x++) BuildColumn(bitmap, x);
+	});
+
+	// diagonal jumps depend on the straight ones, every diagonal line is independent
+	int lineCount = _SizeX + _SizeY - 1;
+	int blockCount = (lineCount + LINE_BLOCK - 1) / LINE_BLOCK;
+	for (int diagonal = 0; diagonal < 4; diagonal++) {
+		ParallelFor(blockCount, threadCount, [&](int block) {
+			for (int line = block * LINE_BLOCK; line < std::min(lineCount, (block + 1) * LINE_BLOCK); line++) {
+				BuildDiagonalLine(bitmap, diagonal, line);
+			}
+		});
+	}
+}
+
+void JpsPlusTable::BuildRow(const ObstacleBitmap& bitmap, int y)
+{
+	for (int dx = -1; dx <= 1; dx += 2) {
+		int dir = JpsPlusDirection(dx, 0);
+		for (int x = (dx > 0) ? _SizeX - 1 : 0; x >= 0 && x < _SizeX; x -= dx) {
+			int nx = x + dx;
+			if (bitmap.Test(nx, y)) {
+				Entry(x, y, dir) = 0;
+			}
+			else if ((!bitmap.Test(nx, y - 1) && bitmap.Test(x, y - 1)) || (!bitmap.Test(nx, y + 1) && bitmap.Test(x, y + 1))) {
+				Entry(x, y, dir) = 1; // next cell has a forced neighbour
+			}
+			else {
+				Entry(x, y, dir) = ContinueJump(Entry(nx, y, dir));
+			}
+		}
+	}
+}
+
+void JpsPlusTable::BuildColumn(const ObstacleBitmap& bitmap, int x)
+{
+	for (int dy = -1; dy <= 1; dy += 2) {
+		int dir = JpsPlusDirection(0, dy);
+		for (int y = (dy > 0) ? _SizeY - 1 : 0; y >= 0 && y < _SizeY; y -= dy) {
+			int ny = y + dy;
+			if (bitmap.Test(x, ny)) {
+				Entry(x, y, dir) = 0;
+			}
+			else if ((!bitmap.Test(x - 1, ny) && bitmap.Test(x - 1, y)) || (!bitmap.Test(x + 1, ny) && bitmap.Test(x + 1, y))) {
+				Entry(x, y, dir) = 1;
+			}
+			else {
+				Entry(x, y, dir) = ContinueJump(Entry(x, ny, dir));
+			}
+		}
+	}
+}
+
+/**
+  * @brief  Recomputes the diagonal entry of a single cell from the next cell on the diagonal.
+  * @retval true if the stored value changed
+  */
+bool JpsPlusTable::UpdateDiagonal(const ObstacleBitmap& bitmap, int x, int y, int dx, int dy)
+{
+	int dir = JpsPlusDirection(dx, dy);
+	int nx = x + dx;
+	int ny = y + dy;
+	int16_t value;
+	if (bitmap.Test(nx, ny) || bitmap.Test(nx, y) || bitmap.Test(x, ny)) {
+		value = 0; // diagonal moves must not cut the corner of an obstacle
+	}
+	else if (Entry(nx, ny, JpsPlusDirection(dx, 0)) > 0 || Entry(nx, ny, JpsPlusDirection(0, dy)) > 0) {
+		value = 1; // a straight jump from the next cell finds a jump point
+	}
+	else {
+		value = ContinueJump(Entry(nx, ny, dir));
+	}
+
+	if (Entry(x, y, dir) == value) return false;
+	Entry(x, y, dir) = value;
+	return true;
+}
+
+void JpsPlusTable::BuildDiagonalLine(const ObstacleBitmap& bitmap, int diagonal, int line)
+{
+	int dx = DIAGONALS[diagonal][0];
+	int dy = DIAGONALS[diagonal][1];
+	// lines start at the far edge of the grid, first on the far column then on the far row
+	int x, y;
+	if (line < _SizeY) {
+		x = (dx > 0) ? _SizeX - 1 : 0;
+		y = line;
+	}
+	else {
+		x = (dx > 0) ? line - _SizeY : line - _SizeY + 1;
+		y = (dy > 0) ? _SizeY - 1 : 0;
+	}
+
+	for (; x >= 0 && x < _SizeX && y >= 0 && y < _SizeY; x -= dx, y -= dy) {
+		UpdateDiagonal(bitmap, x, y, dx, dy);
+	}
+}
+
+void JpsPlusTable::RepairCell(const ObstacleBitmap& bitmap, int x, int y)
+{
+	if (!IsBuilt()) return;
+
+	// straight entries of the cell's row and column and of the side lines around them
+	for (int line = y - 1; line <= y + 1; line++) {
+		if (line >= 0 && line < _SizeY) BuildRow(bitmap, line);
+	}
+	for (int line = x - 1; line <= x + 1; line++) {
+		if (line >= 0 && line < _SizeX) BuildColumn(bitmap, line);
+	}
+
+	// a diagonal entry only reads the next cell on its diagonal, so every cell of the
+	// rebuilt lines is walked back along each diagonal until the values stop changing
+	for (int i = 0; i < 4; i++) {
+		int dx = DIAGONALS[i][0];
+		int dy = DIAGONALS[i][1];
+		auto walkBack = [&](int cx, int cy) {
+			cx -= dx;
+			cy -= dy;
+			while (cx >= 0 && cx < _SizeX && cy >= 0 && cy < _SizeY && UpdateDiagonal(bitmap, cx, cy, dx, dy)) {
+				cx -= dx;
+				cy -= dy;
+			}
+		};
+		for (int line = y - 1; line <= y + 1; line++) {
+			if (line < 0 || line >= _SizeY) continue;
+			for (int cx = 0; cx < _SizeX; cx++) walkBack(cx, line);
+		}
+		for (int line = x - 1; line <= x + 1; line++) {
+			if (line < 0 || line >= _SizeX) continue;
+			for (int cy = 0; cy < _SizeY; cy++) walkBack(line, cy);
+		}
+	}
+}
+
@@ -0,0 +1,58 @@
+/**
+  ******************************************************************************
+  * @file    jps_plus.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the JPS+ jump distance table.
+  *          For every cell and each of the 8 directions the table stores where
+  *          the Jump Point Search jump from that cell ends:
+  *            d > 0  : a jump point is d steps away
+  *            d <= 0 : no jump point, -d steps can be taken before an obstacle
+  *          The target is not part of the table, the online search checks it.
+  ******************************************************************************
+  */
+
+#ifndef JPS_PLUS_H
+#define JPS_PLUS_H
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "obstacle_bitmap.h"
+
+// direction order matches the neighbour table of MapGrid, straight moves first
+static inline int JpsPlusDirection(int dx, int dy)
+{
+	if (dy == 0) return dx < 0 ? 0 : 1;
+	if (dx == 0) return dy < 0 ? 2 : 3;
+	return 4 + (dx > 0 ? 1 : 0) + (dy > 0 ? 2 : 0);
+}
+
+class JpsPlusTable {
+public:
+	// longest side the 16 bit distances can cover, larger maps are not built and search with JPS
+	static const int MAX_SIZE = std::numeric_limits<int16_t>::max();
+
+	// builds the whole table, rows, columns and diagonals are shared between threadCount threads (0 means all cores).
+	// The table stays empty if a side of the bitmap is longer than MAX_SIZE
+	void Build(const ObstacleBitmap& bitmap, int threadCount = 0);
+	// updates the table after the cell at (x, y) changed between free and blocked
+	void RepairCell(const ObstacleBitmap& bitmap, int x, int y);
+	void Clear(void);
+	bool IsBuilt(void) const { return !_Distances.empty(); }
+	int GetDistance(uint32_t cell, int dir) const { return _Distances[cell * 8 + dir]; }
+
+private:
+	int _SizeX = 0;
+	int _SizeY = 0;
+	std::vector<int16_t> _Distances; // 8 entries per cell
+
+	int16_t& Entry(int x, int y, int dir) { return _Distances[((size_t)y * _SizeX + x) * 8 + dir]; }
+	void BuildRow(const ObstacleBitmap& bitmap, int y);
+	void BuildColumn(const ObstacleBitmap& bitmap, int x);
+	void BuildDiagonalLine(const ObstacleBitmap& bitmap, int dir, int line);
+	bool UpdateDiagonal(const ObstacleBitmap& bitmap, int x, int y, int dx, int dy);
+};
+
+#endif
+
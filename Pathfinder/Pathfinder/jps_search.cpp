@@ -0,0 +1,271 @@
+/**
+  ******************************************************************************
+  * @file    jps_search.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of Jump Point Search for 8
+  *          connected uniform cost grids. Diagonal moves never cut obstacle
+  *          corners, so only straight moves can have forced neighbours. Straight
+  *          jumps test 64 cells at a time by scanning the obstacle bitmap words.
+  ******************************************************************************
+  */
+#include "map_grid.h"
+#include <algorithm>
+#include <cstdlib>
+
+static inline uint64_t LineWord(const ObstacleBitmap& bitmap, bool column, int line, int word)
+{
+	return column ? bitmap.GetColumnWord(line, word) : bitmap.GetRowWord(line, word);
+}
+
+/**
+  * @brief  Jumps along a row (or a column) starting next to pos and moving in dir.
+  *         The jump stops at the first cell which is blocked, which is the target
+  *         or which has a forced neighbour on one of the side lines. A cell has a
+  *         forced neighbour when the side cell is free but the side cell behind it
+  *         is blocked.
+  * @retval position of the jump point on the line or -1 if the jump hits an obstacle
+  */
+static int JumpStraight(const ObstacleBitmap& bitmap, bool column, int line, int pos, int dir, int targetPos)
+{
+	int start = pos + dir;
+	if (start < 0) return -1;
+	int word = start >> 6;
+
+	if (dir > 0) {
+		uint64_t startMask = ~0ull << (start & 63);
+		while (true) {
+			uint64_t cells = LineWord(bitmap, column, line, word);
+			uint64_t sideA = LineWord(bitmap, column, line - 1, word);
+			uint64_t sideB = LineWord(bitmap, column, line + 1, word);
+			// bit i of the shifted words tells if the side cell behind cell i is blocked
+			uint64_t behindA = (sideA << 1) | (LineWord(bitmap, column, line - 1, word - 1) >> 63);
+			uint64_t behindB = (sideB << 1) | (LineWord(bitmap, column, line + 1, word - 1) >> 63);
+			uint64_t stop = cells | (~sideA & behindA) | (~sideB & behindB);
+			if (targetPos >= 0 && (targetPos >> 6) == word) stop |= 1ull << (targetPos & 63);
+			stop &= startMask;
+			if (stop) {
+				int bit = CountTrailingZeros64(stop);
+				if ((cells >> bit) & 1) return -1; // padding bits and lines outside of the grid are blocked too
+				return (word << 6) + bit;
+			}
+			startMask = ~0ull;
+			word++;
+		}
+	}
+	else {
+		uint64_t startMask = ~0ull >> (63 - (start & 63));
+		while (word >= 0) {
+			uint64_t cells = LineWord(bitmap, column, line, word);
+			uint64_t sideA = LineWord(bitmap, column, line - 1, word);
+			uint64_t sideB = LineWord(bitmap, column, line + 1, word);
+			uint64_t behindA = (sideA >> 1) | (LineWord(bitmap, column, line - 1, word + 1) << 63);
+			uint64_t behindB = (sideB >> 1) | (LineWord(bitmap, column, line + 1, word + 1) << 63);
+			uint64_t stop = cells | (~sideA & behindA) | (~sideB & behindB);
+			if (targetPos >= 0 && (targetPos >> 6) == word) stop |= 1ull << (targetPos & 63);
+			stop &= startMask;
+			if (stop) {
+				int bit = HighestSetBit64(stop);
+				if ((cells >> bit) & 1) return -1;
+				return (word << 6) + bit;
+			}
+			startMask = ~0ull;
+			word--;
+		}
+		return -1; // left the grid
+	}
+}
+
+static inline bool JumpHorizontal(const ObstacleBitmap& bitmap, int x, int y, int dx, int targetX, int targetY, int& outX)
+{
+	outX = JumpStraight(bitmap, false, y, x, dx, (y == targetY) ? targetX : -1);
+	return outX >= 0;
+}
+
+static inline bool JumpVertical(const ObstacleBitmap& bitmap, int x, int y, int dy, int targetX, int targetY, int& outY)
+{
+	outY = JumpStraight(bitmap, true, x, y, dy, (x == targetX) ? targetY : -1);
+	return outY >= 0;
+}
+
+/**
+  * @brief  Moves diagonally until a cell is found from which a straight jump in one
+  *         of the two component directions finds a jump point.
+  * @retval true if a jump point is found, its position is written to outX, outY
+  */
+static bool JumpDiagonal(const ObstacleBitmap& bitmap, int x, int y, int dx, int dy, int targetX, int targetY, int& outX, int& outY)
+{
+	int unused;
+	while (true) {
+		// diagonal moves must not cut the corner of an obstacle
+		if (bitmap.Test(x + dx, y + dy) || bitmap.Test(x + dx, y) || bitmap.Test(x, y + dy)) return false;
+		x += dx;
+		y += dy;
+		if ((x == targetX && y == targetY) ||
+			JumpHorizontal(bitmap, x, y, dx, targetX, targetY, unused) ||
+			JumpVertical(bitmap, x, y, dy, targetX, targetY, unused)) {
+			outX = x;
+			outY = y;
+			return true;
+		}
+	}
+}
+
+static inline int Sign(int value)
+{
+	return (value > 0) - (value < 0);
+}
+
+/**
+  * @brief  Collects the directions to jump in from a cell, pruned by the direction
+  *         the cell was reached from. Free side cells of a straight move may have
+  *         become forced, the diagonal towards them is checked by the jump itself.
+  * @retval number of directions written to dirs
+  */
+static int CollectJumpDirections(const ObstacleBitmap& bitmap, int x, int y, int dx, int dy, bool isStart, int dirs[8][2])
+{
+	int dirCount = 0;
+	if (isStart) {
+		for (int ny = -1; ny <= 1; ny++) {
+			for (int nx = -1; nx <= 1; nx++) {
+				if (nx != 0 || ny != 0) {
+					dirs[dirCount][0] = nx;
+					dirs[dirCount++][1] = ny;
+				}
+			}
+		}
+	}
+	else if (dx != 0 && dy != 0) {
+		// natural neighbours of a diagonal move
+		dirs[dirCount][0] = dx; dirs[dirCount++][1] = dy;
+		dirs[dirCount][0] = dx; dirs[dirCount++][1] = 0;
+		dirs[dirCount][0] = 0; dirs[dirCount++][1] = dy;
+	}
+	else if (dx != 0) {
+		dirs[dirCount][0] = dx; dirs[dirCount++][1] = 0;
+		for (int side = -1; side <= 1; side += 2) {
+			if (bitmap.Test(x, y + side)) continue;
+			dirs[dirCount][0] = 0; dirs[dirCount++][1] = side;
+			dirs[dirCount][0] = dx; dirs[dirCount++][1] = side;
+		}
+	}
+	else {
+		dirs[dirCount][0] = 0; dirs[dirCount++][1] = dy;
+		for (int side = -1; side <= 1; side += 2) {
+			if (bitmap.Test(x + side, y)) continue;
+			dirs[dirCount][0] = side; dirs[dirCount++][1] = 0;
+			dirs[dirCount][0] = side; dirs[dirCount++][1] = dy;
+		}
+	}
+	return dirCount;
+}
+
+template <typename CostT, typename OpenListT, typename JumpFunc>
+void MapGrid::RunJumpSearch(SearchContext<CostT, OpenListT>& context, JumpFunc jump) const
+{
+	const uint32_t start = context.start;
+	const uint32_t target = context.target;
+	context.TouchCell(start);
+	context.localGoal[start] = 0;
+	int targetX = target % _GridSizeX;
+	int targetY = target / _GridSizeX;
+	context.OpenCell(start, Heuristic<CostT>(start % _GridSizeX, start / _GridSizeX, targetX, targetY));
+
+	while (!context.openList.Empty()) {
+		uint32_t current = context.openList.Pop();
+		context.MarkVisited(current);
+		if (current == target) break;
+
+		int cx = current % _GridSizeX;
+		int cy = current / _GridSizeX;
+		uint32_t parent = context.parent[current];
+		int parentDx = 0;
+		int parentDy = 0;
+		if (parent != NO_PARENT) {
+			parentDx = Sign(cx - (int)(parent % _GridSizeX));
+			parentDy = Sign(cy - (int)(parent / _GridSizeX));
+		}
+
+		int dirs[8][2];
+		int dirCount = CollectJumpDirections(_Obstacles, cx, cy, parentDx, parentDy, parent == NO_PARENT, dirs);
+		for (int i = 0; i < dirCount; i++) {
+			int jx = cx;
+			int jy = cy;
+			if (!jump(cx, cy, dirs[i][0], dirs[i][1], targetX, targetY, jx, jy)) continue;
+
+			uint32_t jumpPoint = jy * _GridSizeX + jx;
+			if (context.IsCellVisited(jumpPoint)) continue;
+			context.TouchCell(jumpPoint);
+
+			// jump points are on a straight or diagonal line from the current cell
+			CostT localGoal = context.localGoal[current] + Distance<CostT>(cx, cy, jx, jy);
+			if (localGoal < context.localGoal[jumpPoint]) {
+				context.parent[jumpPoint] = current;
+				context.localGoal[jumpPoint] = localGoal;
+				context.OpenCell(jumpPoint, localGoal + Heuristic<CostT>(jx, jy, targetX, targetY));
+			}
+		}
+	}
+}
+
+std::vector<MapGrid::GridPos> MapGrid::Find_JPS_Path()
+{
+	return Find_JPS_Path(_Search);
+}
+
+template <typename CostT, typename OpenListT>
+void MapGrid::RunJPS(SearchContext<CostT, OpenListT>& context) const
+{
+	const ObstacleBitmap& bitmap = _Obstacles;
+	RunJumpSearch(context, [&bitmap](int x, int y, int dx, int dy, int targetX, int targetY, int& outX, int& outY) {
+		if (dx != 0 && dy != 0) return JumpDiagonal(bitmap, x, y, dx, dy, targetX, targetY, outX, outY);
+		if (dx != 0) return JumpHorizontal(bitmap, x, y, dx, targetX, targetY, outX);
+		return JumpVertical(bitmap, x, y, dy, targetX, targetY, outY);
+	});
+}
+
+std::vector<MapGrid::GridPos> MapGrid::Find_JPSPlus_Path()
+{
+	return Find_JPSPlus_Path(_Search);
+}
+
+template <typename CostT, typename OpenListT>
+void MapGrid::RunJPSPlus(SearchContext<CostT, OpenListT>& context) const
+{
+	const JpsPlusTable& table = _JpsPlus;
+	const int sizeX = _GridSizeX;
+	RunJumpSearch(context, [&table, sizeX](int x, int y, int dx, int dy, int targetX, int targetY, int& outX, int& outY) {
+		int distance = table.GetDistance(y * sizeX + x, JpsPlusDirection(dx, dy));
+		int reach = distance > 0 ? distance : -distance; // steps that can be taken in this direction
+		int toTargetX = (targetX - x) * dx;
+		int toTargetY = (targetY - y) * dy;
+		if (dx == 0 || dy == 0) {
+			// target on this line before the jump point or the wall
+			int toTarget = (dx != 0) ? toTargetX : toTargetY;
+			bool onLine = (dx != 0) ? (targetY == y) : (targetX == x);
+			if (onLine && toTarget > 0 && toTarget <= reach) {
+				outX = targetX;
+				outY = targetY;
+				return true;
+			}
+		}
+		else if (toTargetX > 0 && toTargetY > 0) {
+			// target inside the quadrant, stop where the diagonal gets in line with it
+			int steps = std::min(toTargetX, toTargetY);
+			if (steps <= reach) {
+				outX = x + steps * dx;
+				outY = y + steps * dy;
+				return true;
+			}
+		}
+		if (distance <= 0) return false;
+		outX = x + distance * dx;
+		outY = y + distance * dy;
+		return true;
+	});
+}
+
+#define INSTANTIATE_JPS(CONTEXT) \
+	template void MapGrid::RunJPS(CONTEXT& context) const; \
+	template void MapGrid::RunJPSPlus(CONTEXT& context) const;
+FOR_EACH_SEARCH_CONTEXT(INSTANTIATE_JPS)
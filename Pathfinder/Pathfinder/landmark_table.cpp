@@ -0,0 +1,284 @@
+/**
+  ******************************************************************************
+  * @file    landmark_table.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the implementation of the ALT landmark table.
+  ******************************************************************************
+  */
+#include "landmark_table.h"
+#include "map_grid.h"
+#include "bucket_queue.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <fstream>
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define LANDMARK_SSE2
+#endif
+
+const int LandmarkTable::MAX_LANDMARKS;
+
+static const int SELECTION_BLOCK = 8; // landmarks are selected on a grid of 8x8 cell blocks
+static const uint32_t NO_CELL = 0xFFFFFFFFu;
+static const uint32_t FILE_MAGIC = 0x31544C41u; // "ALT1"
+
+struct LandmarkFileHeader {
+	uint32_t magic;
+	int32_t sizeX;
+	int32_t sizeY;
+	int32_t landmarkCount;
+	int32_t stride;
+	uint32_t quantum;
+	uint32_t entryBytes;
+	uint32_t reserved;
+	uint64_t fingerprint;
+};
+
+/**
+  * @brief  Dijkstra on a row major grid from source, moveAllowed(x, y, dx, dy) gives the
+  *         moves. Costs are the fixed point step costs of MapGrid, cells that are not
+  *         reached keep COST_INFINITY.
+  */
+template <typename MoveFunc>
+static void GridDijkstra(int sizeX, int sizeY, int neighbourCount, uint32_t source, MoveFunc moveAllowed, std::vector<uint32_t>& distance)
+{
+	int dirX[8];
+	int dirY[8];
+	uint32_t stepCost[8];
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		dirX[dir] = offset.first;
+		dirY[dir] = offset.second;
+		stepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	size_t cellCount = (size_t)sizeX * sizeY;
+	distance.assign(cellCount, MapGrid::COST_INFINITY);
+	BucketQueue<uint32_t> open(cellCount);
+	distance[source] = 0;
+	open.PushOrDecrease(source, 0, 0);
+	while (!open.Empty()) {
+		uint32_t current = open.Pop();
+		int cx = current % sizeX;
+		int cy = current / sizeX;
+		for (int dir = 0; dir < neighbourCount; dir++) {
+			if (!moveAllowed(cx, cy, dirX[dir], dirY[dir])) continue;
+			uint32_t neighbour = (cy + dirY[dir]) * sizeX + cx + dirX[dir];
+			uint32_t neighbourDistance = distance[current] + stepCost[dir];
+			if (neighbourDistance < distance[neighbour]) {
+				distance[neighbour] = neighbourDistance;
+				open.PushOrDecrease(neighbour, neighbourDistance, 0);
+			}
+		}
+	}
+}
+
+void LandmarkTable::Clear(void)
+{
+	_LandmarkCount = 0;
+	_Stride = 0;
+	_Quantum = 1;
+	_Landmarks.clear();
+	_Table16.clear();
+	_Table16.shrink_to_fit();
+	_Table32.clear();
+	_Table32.shrink_to_fit();
+}
+
+void LandmarkTable::Build(const MapGrid& map, int landmarkCount, int threadCount)
+{
+	Clear();
+	SelectLandmarks(map, std::min(std::max(landmarkCount, 1), MAX_LANDMARKS));
+	if (_Landmarks.empty()) return; // every cell is blocked
+
+	MapGrid::GridSize size = map.GetGridSize();
+	size_t cellCount = (size_t)size.first * size.second;
+	int count = (int)_Landmarks.size();
+	int stride = (count + 3) & ~3;
+	std::vector<uint32_t> table(cellCount * stride, 0);
+	auto moveAllowed = [&map](int x, int y, int dx, int dy) { return map.IsMoveAllowed(x, y, dx, dy); };
+	ParallelFor(count, threadCount, [&](int landmark) {
+		std::vector<uint32_t> distance;
+		GridDijkstra(size.first, size.second, map.GetNeighbourCount(), _Landmarks[landmark], moveAllowed, distance);
+		for (size_t cell = 0; cell < cellCount; cell++) {
+			if (distance[cell] != MapGrid::COST_INFINITY) table[cell * stride + landmark] = distance[cell];
+		}
+	});
+
+	// every distance of a 4 connected grid is a whole number of straight steps
+	uint32_t largest = *std::max_element(table.begin(), table.end());
+	_LandmarkCount = count;
+	if (map.GetNeighbourCount() == 4 && largest / MapGrid::COST_STRAIGHT <= 0xFFFF) {
+		_Quantum = MapGrid::COST_STRAIGHT;
+		_Stride = (count + 7) & ~7;
+		_Table16.assign(cellCount * _Stride, 0);
+		for (size_t cell = 0; cell < cellCount; cell++) {
+			for (int landmark = 0; landmark < count; landmark++) {
+				_Table16[cell * _Stride + landmark] = (uint16_t)(table[cell * stride + landmark] / _Quantum);
+			}
+		}
+	}
+	else {
+		_Quantum = 1;
+		_Stride = stride;
+		_Table32.swap(table);
+	}
+}
+
+/**
+  * @brief  Farthest point selection: every new landmark is the cell farthest from the
+  *         landmarks chosen so far, regions without a landmark come first. The
+  *         distances come from Dijkstra on 8x8 cell blocks, a block is free if one of
+  *         its cells is, which is accurate enough to spread the landmarks out.
+  */
+void LandmarkTable::SelectLandmarks(const MapGrid& map, int landmarkCount)
+{
+	const ObstacleBitmap& obstacles = map.GetObstacleBitmap();
+	MapGrid::GridSize size = map.GetGridSize();
+	int blocksX = (size.first + SELECTION_BLOCK - 1) / SELECTION_BLOCK;
+	int blocksY = (size.second + SELECTION_BLOCK - 1) / SELECTION_BLOCK;
+	std::vector<uint32_t> blockCell((size_t)blocksX * blocksY, NO_CELL); // first free cell of each block
+	for (int y = 0; y < size.second; y++) {
+		for (int x = 0; x < size.first; x++) {
+			uint32_t& cell = blockCell[(y / SELECTION_BLOCK) * blocksX + x / SELECTION_BLOCK];
+			if (cell == NO_CELL && !obstacles.Test(x, y)) cell = y * size.first + x;
+		}
+	}
+	uint32_t seed = (uint32_t)(std::find_if(blockCell.begin(), blockCell.end(), [](uint32_t cell) { return cell != NO_CELL; }) - blockCell.begin());
+	if (seed == blockCell.size()) return;
+
+	auto moveAllowed = [&](int x, int y, int dx, int dy) {
+		int nx = x + dx;
+		int ny = y + dy;
+		return nx >= 0 && ny >= 0 && nx < blocksX && ny < blocksY && blockCell[ny * blocksX + nx] != NO_CELL;
+	};
+	std::vector<uint32_t> distance;
+	auto farthest = [&](const std::vector<uint32_t>& costs) {
+		uint32_t best = seed;
+		for (uint32_t block = 0; block < costs.size(); block++) {
+			if (blockCell[block] != NO_CELL && costs[block] > costs[best]) best = block;
+		}
+		return best;
+	};
+
+	// the first landmark is the farthest block from an arbitrary one, usually near the map's edge
+	GridDijkstra(blocksX, blocksY, map.GetNeighbourCount(), seed, moveAllowed, distance);
+	uint32_t landmark = farthest(distance);
+	std::vector<uint32_t> nearest(blockCell.size(), MapGrid::COST_INFINITY); // distance to the nearest landmark
+	while (true) {
+		_Landmarks.push_back(blockCell[landmark]);
+		if ((int)_Landmarks.size() == landmarkCount) break;
+		GridDijkstra(blocksX, blocksY, map.GetNeighbourCount(), landmark, moveAllowed, distance);
+		for (size_t block = 0; block < nearest.size(); block++) nearest[block] = std::min(nearest[block], distance[block]);
+		landmark = farthest(nearest);
+		if (nearest[landmark] == 0) break; // fewer free blocks than landmarks
+	}
+}
+
+uint32_t LandmarkTable::LowerBound(uint32_t cell, uint32_t target) const
+{
+	if (!_Table16.empty()) {
+		const uint16_t* a = &_Table16[(size_t)cell * _Stride];
+		const uint16_t* b = &_Table16[(size_t)target * _Stride];
+		uint32_t largest = 0;
+#if defined(LANDMARK_SSE2)
+		// unsigned saturating subtraction both ways gives |a - b|, max(x, y) is (x - y) + y
+		__m128i best = _mm_setzero_si128();
+		for (int k = 0; k < _Stride; k += 8) {
+			__m128i va = _mm_loadu_si128((const __m128i*)(a + k));
+			__m128i vb = _mm_loadu_si128((const __m128i*)(b + k));
+			__m128i diff = _mm_or_si128(_mm_subs_epu16(va, vb), _mm_subs_epu16(vb, va));
+			best = _mm_add_epi16(_mm_subs_epu16(best, diff), diff);
+		}
+		__m128i other = _mm_srli_si128(best, 8);
+		best = _mm_add_epi16(_mm_subs_epu16(best, other), other);
+		other = _mm_srli_si128(best, 4);
+		best = _mm_add_epi16(_mm_subs_epu16(best, other), other);
+		other = _mm_srli_si128(best, 2);
+		best = _mm_add_epi16(_mm_subs_epu16(best, other), other);
+		largest = (uint32_t)_mm_cvtsi128_si32(best) & 0xFFFF;
+#else
+		for (int k = 0; k < _LandmarkCount; k++) {
+			uint32_t diff = a[k] > b[k] ? a[k] - b[k] : b[k] - a[k];
+			largest = std::max(largest, diff);
+		}
+#endif
+		return largest * _Quantum;
+	}
+
+	const uint32_t* a = &_Table32[(size_t)cell * _Stride];
+	const uint32_t* b = &_Table32[(size_t)target * _Stride];
+#if defined(LANDMARK_SSE2)
+	// SSE2 only compares signed lanes, flipping the top bit orders unsigned values the same way
+	const __m128i sign = _mm_set1_epi32((int)0x80000000u);
+	__m128i best = _mm_setzero_si128(); // |a - b| of every lane, stored with the top bit flipped
+	best = _mm_xor_si128(best, sign);
+	for (int k = 0; k < _Stride; k += 4) {
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + k));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + k));
+		__m128i greater = _mm_cmpgt_epi32(_mm_xor_si128(va, sign), _mm_xor_si128(vb, sign));
+		__m128i diff = _mm_or_si128(_mm_and_si128(greater, _mm_sub_epi32(va, vb)), _mm_andnot_si128(greater, _mm_sub_epi32(vb, va)));
+		diff = _mm_xor_si128(diff, sign);
+		__m128i larger = _mm_cmpgt_epi32(diff, best);
+		best = _mm_or_si128(_mm_and_si128(larger, diff), _mm_andnot_si128(larger, best));
+	}
+	uint32_t lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(best, sign));
+	return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#else
+	uint32_t largest = 0;
+	for (int k = 0; k < _LandmarkCount; k++) {
+		uint32_t diff = a[k] > b[k] ? a[k] - b[k] : b[k] - a[k];
+		largest = std::max(largest, diff);
+	}
+	return largest;
+#endif
+}
+
+bool LandmarkTable::Save(const char* fileName, const MapGrid& map) const
+{
+	if (!IsBuilt()) return false;
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file) return false;
+	MapGrid::GridSize size = map.GetGridSize();
+	LandmarkFileHeader header = { FILE_MAGIC, size.first, size.second, _LandmarkCount, _Stride, _Quantum, (uint32_t)GetEntryBytes(), 0, map.GetFingerprint() };
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)_Landmarks.data(), _Landmarks.size() * sizeof(uint32_t));
+	if (!_Table16.empty()) file.write((const char*)_Table16.data(), _Table16.size() * sizeof(uint16_t));
+	else file.write((const char*)_Table32.data(), _Table32.size() * sizeof(uint32_t));
+	return (bool)file;
+}
+
+bool LandmarkTable::Load(const char* fileName, const MapGrid& map)
+{
+	Clear();
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file) return false;
+	LandmarkFileHeader header;
+	if (!file.read((char*)&header, sizeof(header))) return false;
+	MapGrid::GridSize size = map.GetGridSize();
+	if (header.magic != FILE_MAGIC || header.sizeX != size.first || header.sizeY != size.second ||
+		header.landmarkCount <= 0 || header.landmarkCount > MAX_LANDMARKS || (header.entryBytes != 2 && header.entryBytes != 4) ||
+		header.stride < header.landmarkCount || header.stride % (16 / (int)header.entryBytes) != 0 || header.quantum == 0 ||
+		header.fingerprint != map.GetFingerprint()) return false;
+
+	size_t entryCount = (size_t)size.first * size.second * header.stride;
+	_Landmarks.resize(header.landmarkCount);
+	bool ok = (bool)file.read((char*)_Landmarks.data(), _Landmarks.size() * sizeof(uint32_t));
+	if (ok && header.entryBytes == 2) {
+		_Table16.resize(entryCount);
+		ok = (bool)file.read((char*)_Table16.data(), entryCount * sizeof(uint16_t));
+	}
+	else if (ok) {
+		_Table32.resize(entryCount);
+		ok = (bool)file.read((char*)_Table32.data(), entryCount * sizeof(uint32_t));
+	}
+	if (!ok) {
+		Clear();
+		return false;
+	}
+	_LandmarkCount = header.landmarkCount;
+	_Stride = header.stride;
+	_Quantum = header.quantum;
+	return true;
+}
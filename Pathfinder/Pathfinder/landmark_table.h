@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    landmark_table.h
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the declaration of the ALT landmark table. A few
+  *          landmark cells are spread over the map by farthest point selection
+  *          and the shortest distance from every landmark to every cell is
+  *          stored. By the triangle inequality |d(L, t) - d(L, v)| never
+  *          overestimates d(v, t), the largest bound over the landmarks is the
+  *          heuristic. The distances of one cell are stored next to each other
+  *          so the bound of all landmarks is found with a few SIMD operations.
+  *          Distances are kept in 16 bits when every distance of the map is a
+  *          whole number of quanta below 65536 (4 connected grids), in 32 bits
+  *          otherwise, so the bound is exact and the heuristic stays consistent.
+  ******************************************************************************
+  */
+
+#ifndef LANDMARK_TABLE_H
+#define LANDMARK_TABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class MapGrid;
+
+class LandmarkTable {
+public:
+	static const int MAX_LANDMARKS = 64;
+
+	// selects landmarkCount landmarks (at most MAX_LANDMARKS) and runs one Dijkstra per landmark,
+	// the Dijkstras are shared between threadCount threads (0 means all cores)
+	void Build(const MapGrid& map, int landmarkCount, int threadCount = 0);
+	void Clear(void);
+	bool IsBuilt(void) const { return _LandmarkCount > 0; }
+	int GetLandmarkCount(void) const { return _LandmarkCount; }
+	uint32_t GetLandmarkCell(int landmark) const { return _Landmarks[landmark]; }
+	size_t GetEntryBytes(void) const { return _Table16.empty() ? sizeof(uint32_t) : sizeof(uint16_t); }
+
+	// binary file tied to the obstacles and move rules of the map, loading a table of another map fails
+	bool Save(const char* fileName, const MapGrid& map) const;
+	bool Load(const char* fileName, const MapGrid& map);
+
+	// fixed point lower bound of the cost between two cells of the same region
+	uint32_t LowerBound(uint32_t cell, uint32_t target) const;
+
+private:
+	int _LandmarkCount = 0;
+	int _Stride = 0; // entries per cell, the landmark count rounded up to a whole SIMD register
+	uint32_t _Quantum = 1; // fixed point cost of one table unit
+	std::vector<uint32_t> _Landmarks; // cell of each landmark
+	// one of them is used, landmark distances of a cell are next to each other. Cells a
+	// landmark does not reach store 0, both cells of a query are then unreached from it
+	std::vector<uint16_t> _Table16;
+	std::vector<uint32_t> _Table32;
+
+	void SelectLandmarks(const MapGrid& map, int landmarkCount);
+};
+
+#endif
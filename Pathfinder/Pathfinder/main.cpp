@@ -27,10 +27,19 @@
  */
 
 #include "app_window.h"
+#include "benchmark.h"
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 
-int main()
+int main(int argc, char* argv[])
 {
+	// "--bench [grid size]" runs the console benchmark instead of the demo window
+	if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+		Run_Benchmark(argc > 2 ? atoi(argv[2]) : 1024);
+		return EXIT_SUCCESS;
+	}
+
 	Start_AppWindow();
 	return EXIT_SUCCESS;
 }
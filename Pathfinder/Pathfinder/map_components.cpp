@@ -0,0 +1,136 @@
+/**
+  ******************************************************************************
+  * @file    map_components.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the connected component labels of MapGrid. A row
+  *          major sweep joins every free cell with its free neighbours that come
+  *          before it, using the move rules of the grid. Obstacle changes keep
+  *          the labels up to date: a freed cell joins its neighbours, a blocked
+  *          cell only causes a new sweep when its free neighbours can not reach
+  *          each other around it, which is the only way it can split a region.
+  ******************************************************************************
+  */
+#include "map_grid.h"
+
+const uint32_t ComponentLabels::NO_COMPONENT;
+
+// same order as the neighbour table of the searches, straight moves first
+static const int RING_X[8] = { -1, 1, 0, 0, -1, 1, -1, 1 };
+static const int RING_Y[8] = { 0, 0, -1, 1, -1, -1, 1, 1 };
+
+void MapGrid::BuildComponentLabels(void)
+{
+	SweepComponents();
+}
+
+bool MapGrid::AreConnected(GridPos a, GridPos b) const
+{
+	uint32_t idxA;
+	uint32_t idxB;
+	if (!IsQueryCell(a, idxA) || !IsQueryCell(b, idxB)) return false;
+	if (!_Components.IsBuilt()) return true; // unknown without the labels
+	return _Components.AreConnected(idxA, idxB);
+}
+
+void MapGrid::SweepComponents(void)
+{
+	_Components.Reset((size_t)_GridSizeX * _GridSizeY);
+	// neighbours already swept: left, then the three cells of the row below
+	const int backX[4] = { -1, 0, -1, 1 };
+	const int backY[4] = { 0, -1, -1, -1 };
+	const int backCount = (_Connectivity == Connectivity::Eight) ? 4 : 2;
+	for (int y = 0; y < _GridSizeY; y++) {
+		for (int x = 0; x < _GridSizeX; x++) {
+			if (_Obstacles.Test(x, y)) continue;
+			uint32_t idx = y * _GridSizeX + x;
+			for (int i = 0; i < backCount; i++) {
+				int nx = x + backX[i];
+				int ny = y + backY[i];
+				if (_Obstacles.Test(nx, ny)) continue;
+				if (i >= 2 && !IsDiagonalMoveAllowed(x, y, nx, ny)) continue;
+				_Components.Union(idx, ny * _GridSizeX + nx);
+			}
+		}
+	}
+	// labels point straight at the roots, so lookups do not walk the trees
+	for (int y = 0; y < _GridSizeY; y++) {
+		for (int x = 0; x < _GridSizeX; x++) {
+			if (_Obstacles.Test(x, y)) continue;
+			uint32_t idx = y * _GridSizeX + x;
+			_Components.SetLabel(idx, _Components.FindAndCompress(idx));
+		}
+	}
+}
+
+void MapGrid::FreeComponentCell(int x, int y)
+{
+	uint32_t idx = y * _GridSizeX + x;
+	// nodes of cells freed earlier stay in the trees, a sweep drops them. One sweep per cell
+	// count of frees keeps the cost per free constant
+	if (_Components.GetNodeCount() >= 2 * (size_t)_GridSizeX * _GridSizeY) {
+		SweepComponents();
+		return;
+	}
+	uint32_t node = _Components.AddNode();
+	_Components.SetLabel(idx, node);
+	// diagonal moves between two neighbours that needed this cell free go through it anyway
+	for (int dir = 0; dir < _NeighbourCount; dir++) {
+		int nx = x + RING_X[dir];
+		int ny = y + RING_Y[dir];
+		if (_Obstacles.Test(nx, ny)) continue;
+		if (dir >= 4 && !IsDiagonalMoveAllowed(x, y, nx, ny)) continue;
+		_Components.Union(node, _Components.GetLabel(ny * _GridSizeX + nx));
+	}
+}
+
+void MapGrid::BlockComponentCell(int x, int y)
+{
+	_Components.SetLabel(y * _GridSizeX + x, ComponentLabels::NO_COMPONENT);
+	if (MaySplitComponent(x, y)) SweepComponents();
+}
+
+/**
+  * @brief  Checks if the free neighbours of a cell that has just been blocked
+  *         can still reach each other through the 8 cells around it. Diagonal
+  *         moves that passed the corner of the cell join two of its straight
+  *         neighbours, so they are covered as well. A path around the cell may
+  *         exist further away, the check is conservative.
+  * @retval true if blocking the cell may have split its region
+  */
+bool MapGrid::MaySplitComponent(int x, int y) const
+{
+	// ring cells that had a move to the blocked cell, the diagonal ones do not depend on it
+	unsigned mustReach = 0;
+	unsigned free = 0;
+	for (int dir = 0; dir < 8; dir++) {
+		int nx = x + RING_X[dir];
+		int ny = y + RING_Y[dir];
+		if (_Obstacles.Test(nx, ny)) continue;
+		free |= 1u << dir;
+		if (dir < _NeighbourCount && (dir < 4 || IsDiagonalMoveAllowed(x, y, nx, ny))) mustReach |= 1u << dir;
+	}
+	if ((mustReach & (mustReach - 1)) == 0) return false; // zero or one neighbour
+
+	// flood fill over the ring with the moves of the grid, the blocked cell is not used
+	unsigned reached = mustReach & (~mustReach + 1);
+	unsigned pending = reached;
+	while (pending) {
+		int a = CountTrailingZeros64(pending);
+		pending &= pending - 1;
+		int ax = x + RING_X[a];
+		int ay = y + RING_Y[a];
+		for (int b = 0; b < 8; b++) {
+			if (!((free & ~reached) >> b & 1u)) continue;
+			int bx = x + RING_X[b];
+			int by = y + RING_Y[b];
+			int dx = bx - ax;
+			int dy = by - ay;
+			if (dx < -1 || dx > 1 || dy < -1 || dy > 1) continue;
+			if (dx != 0 && dy != 0 && (_NeighbourCount == 4 || !IsDiagonalMoveAllowed(ax, ay, bx, by))) continue;
+			reached |= 1u << b;
+			pending |= 1u << b;
+		}
+	}
+	return (reached & mustReach) != mustReach;
+}
@@ -8,56 +8,91 @@
   */
 #include "map_grid.h"
 #include <iostream>
-#include <queue>
-#include <list>
 #include <algorithm>
+#include <cstdlib>
+#include <type_traits>
+#include <limits>
 
-MapGrid::MapGrid(int SizeX = 10, int SizeY = 10)
+const uint32_t MapGrid::NO_PARENT;
+const MapGrid::Cost MapGrid::COST_STRAIGHT;
+const MapGrid::Cost MapGrid::COST_DIAGONAL;
+const MapGrid::Cost MapGrid::COST_INFINITY;
+const size_t MapGrid::CHANGE_HISTORY;
+
+// neighbour directions, straight moves first so 4 connected grids use the first half
+static const int DIR_X[8] = { -1, 1, 0, 0, -1, 1, -1, 1 };
+static const int DIR_Y[8] = { 0, 0, -1, 1, -1, -1, 1, 1 };
+
+MapGrid::MapGrid(int SizeX, int SizeY, Connectivity connectivity, CornerCutting cornerCutting)
 {
 	_GridSizeX = SizeX;
 	_GridSizeY = SizeY;
+	_Connectivity = connectivity;
+	_CornerCutting = cornerCutting;
+	_NeighbourCount = (connectivity == Connectivity::Eight) ? 8 : 4;
 	ResetMap();
 	// set initial start and target
-	_Start = &_Nodes[0]; // bottom left corner
-	_Target = &_Nodes[(_GridSizeX * _GridSizeY) - 1]; // top right corner
+	_Start = 0; // bottom left corner
+	_Target = (_GridSizeX * _GridSizeY) - 1; // top right corner
+}
+
+MapGrid::GridView MapGrid::GetGridView(void) const
+{
+	return GridView(*this);
 }
 
-MapGrid::Node* MapGrid::GetGridArray(void)
+const ObstacleBitmap& MapGrid::GetObstacleBitmap(void) const
 {
-	return _Nodes;
+	return _Obstacles;
 }
 
-MapGrid::GridSize MapGrid::GetGridSize(void)
+MapGrid::GridSize MapGrid::GetGridSize(void) const
 {
 	return GridSize(_GridSizeX, _GridSizeY);
 }
 
-MapGrid::Node* MapGrid::GetTargetNode(void)
+int MapGrid::GetExpandedNodeCount(void) const
 {
-	return _Target;
+	return _Search.expandedNodeCount;
 }
 
-MapGrid::Node* MapGrid::GetStartNode(void)
+MapGrid::Connectivity MapGrid::GetConnectivity(void) const
 {
-	return _Start;
+	return _Connectivity;
 }
 
-MapGrid::GridPos MapGrid::GetTargetPos(void)
+MapGrid::CornerCutting MapGrid::GetCornerCutting(void) const
 {
-	return GridPos(_Target->x, _Target->y);
+	return _CornerCutting;
+}
+
+MapGrid::Cost MapGrid::GetLastPathCost(void) const
+{
+	return _Search.IsCellVisited(_Search.target) ? _Search.localGoal[_Search.target] : COST_INFINITY;
+}
+
+bool MapGrid::UsesJumpRules(void) const
+{
+	// jump point pruning assumes 8 connected moves that never cut obstacle corners
+	return _Connectivity == Connectivity::Eight && _CornerCutting == CornerCutting::Never;
+}
+
+MapGrid::GridPos MapGrid::GetTargetPos(void) const
+{
+	return GridPos(_Target % _GridSizeX, _Target / _GridSizeX);
 }
 
 void MapGrid::SetTargetPos(GridPos targetPos)
 {
 	int idx = targetPos.second * _GridSizeX + targetPos.first;
-	if (idx > (_GridSizeX * _GridSizeY) || idx < 0) return;
-	_Target = &_Nodes[idx];
-	_Target->isObstacle = false; // in case if its obstacle
+	if (idx > (_GridSizeX * _GridSizeY - 1) || idx < 0) return;
+	_Target = idx;
+	SetCellObstacle(idx, false); // in case if its obstacle
 }
 
-MapGrid::GridPos MapGrid::GetStartPos(void)
+MapGrid::GridPos MapGrid::GetStartPos(void) const
 {
-	return GridPos(_Start->x, _Start->y);
+	return GridPos(_Start % _GridSizeX, _Start / _GridSizeX);
 }
 
 
@@ -65,120 +100,499 @@ void MapGrid::SetStartPos(GridPos startPos)
 {
 	int idx = startPos.second * _GridSizeX + startPos.first;
 	if (idx > (_GridSizeX * _GridSizeY - 1) || idx < 0) return;
-	_Start = &_Nodes[idx];
-	_Start->isObstacle = false; // in case if its obstacle
+	_Start = idx;
+	SetCellObstacle(idx, false); // in case if its obstacle
 }
 
 void MapGrid::ToggleObstacle(GridPos obstaclePos)
 {
 	int idx = obstaclePos.second * _GridSizeX + obstaclePos.first;
 	if (idx > (_GridSizeX * _GridSizeY - 1) || idx < 0) return; // if index is outside the array then return
-	if (&_Nodes[idx] == _Target || &_Nodes[idx] == _Start) return; // if index hits target or start then return
-	_Nodes[idx].isObstacle ^= true;
+	if ((uint32_t)idx == _Target || (uint32_t)idx == _Start) return; // if index hits target or start then return
+	SetCellObstacle(idx, !_Obstacles.Test(idx % _GridSizeX, idx / _GridSizeX));
 }
 
-void MapGrid::ResetMap()
+void MapGrid::SetCellObstacle(uint32_t idx, bool blocked)
 {
-	if (_Nodes == nullptr) {
-		_Nodes = new Node[_GridSizeX * _GridSizeY];
+	int x = idx % _GridSizeX;
+	int y = idx / _GridSizeX;
+	if (_Obstacles.Test(x, y) == blocked) return;
+	_Obstacles.Set(x, y, blocked);
+	// a freed cell needs a cost, blocked cells may have kept 0 from the terrain layer
+	if (!blocked && !_Terrain.empty() && _Terrain[idx] == 0) {
+		_Terrain[idx] = 1;
+		_TerrainMinCost = 1;
+	}
+	if (_Changes.size() < CHANGE_HISTORY) _Changes.push_back(idx);
+	else _Changes[_Version % CHANGE_HISTORY] = idx;
+	_Version++;
+	// keep the preprocessed layers in sync with the obstacles
+	_JpsPlus.RepairCell(_Obstacles, x, y);
+	if (_Components.IsBuilt()) {
+		if (blocked) BlockComponentCell(x, y);
+		else FreeComponentCell(x, y);
 	}
+	// blocking only makes distances longer, the old bounds stay admissible and consistent
+	if (!blocked && _Landmarks.IsBuilt()) _Landmarks.Clear();
+}
 
-	for (int x = 0; x < _GridSizeX; x++)
-	{
-		for (int y = 0; y < _GridSizeY; y++)
-		{
-			_Nodes[y * _GridSizeX + x].x = x;
-			_Nodes[y * _GridSizeX + x].y = y;
-			_Nodes[y * _GridSizeX + x].parent = nullptr;
-			//_Nodes[y * _GridSizeX + x].isObstacle = false; // keep the obstacle value for new calculation
-			_Nodes[y * _GridSizeX + x].isVisited = false;
-			_Nodes[y * _GridSizeX + x].globalGoal = INFINITY;
-			_Nodes[y * _GridSizeX + x].localGoal = INFINITY;
-			_Nodes[y * _GridSizeX + x].neighbours.clear();
-		}
+bool MapGrid::LoadTerrain(Span<const uint8_t> costs)
+{
+	size_t cellCount = (size_t)_GridSizeX * _GridSizeY;
+	if (costs.size() != cellCount) return false;
+	if (_Terrain.empty()) _Terrain.assign(cellCount, 1);
+	bool changed = false;
+	bool freed = false;
+	for (size_t idx = 0; idx < cellCount; idx++) changed |= WriteCellTerrain((uint32_t)idx, costs[idx], freed);
+	if (changed) ApplyFullMapChange(freed);
+	UpdateTerrainMinCost();
+	return true;
+}
+
+bool MapGrid::UpdateTerrain(GridPos origin, int width, int height, Span<const uint8_t> costs)
+{
+	if (origin.first < 0 || origin.second < 0 || width < 0 || height < 0) return false;
+	if (origin.first + width > _GridSizeX || origin.second + height > _GridSizeY) return false;
+	if (costs.size() != (size_t)width * height) return false;
+	if (_Terrain.empty()) _Terrain.assign((size_t)_GridSizeX * _GridSizeY, 1);
+	bool changed = false;
+	bool freed = false;
+	for (int y = 0; y < height; y++) {
+		uint32_t row = (origin.second + y) * _GridSizeX + origin.first;
+		for (int x = 0; x < width; x++) changed |= WriteCellTerrain(row + x, costs[(size_t)y * width + x], freed);
 	}
+	if (changed) ApplyFullMapChange(freed);
+	// raised costs may have lifted the lowest one, the heuristic gets as tight as possible again
+	UpdateTerrainMinCost();
+	return true;
+}
 
-	for (int x = 0; x < _GridSizeX; x++)
-	{
-		for (int y = 0; y < _GridSizeY; y++)
-		{
-			if (x > 0) {
-				_Nodes[y * _GridSizeX + x].neighbours.push_back(&_Nodes[y * _GridSizeX + (x - 1)]);
-			}
-			if (x < (_GridSizeX - 1)) {
-				_Nodes[y * _GridSizeX + x].neighbours.push_back(&_Nodes[y * _GridSizeX + (x + 1)]);
-			}
-			if (y > 0) {
-				_Nodes[y * _GridSizeX + x].neighbours.push_back(&_Nodes[(y - 1) * _GridSizeX + x]);
-			}
-			if (y < (_GridSizeY - 1)) {
-				_Nodes[y * _GridSizeX + x].neighbours.push_back(&_Nodes[(y + 1) * _GridSizeX + x]);
-			}
-		}
+void MapGrid::SetTerrainCost(GridPos pos, uint8_t cost)
+{
+	if (pos.first < 0 || pos.second < 0 || pos.first >= _GridSizeX || pos.second >= _GridSizeY) return;
+	if (_Terrain.empty()) _Terrain.assign((size_t)_GridSizeX * _GridSizeY, 1);
+	// only lowers the heuristic scale, a raised cost leaves it low until the next bulk update
+	SetCellTerrain(pos.second * _GridSizeX + pos.first, cost);
+}
+
+uint8_t MapGrid::GetTerrainCost(GridPos pos) const
+{
+	if (_Obstacles.Test(pos.first, pos.second)) return 0; // outside of the grid reads as blocked too
+	return _Terrain.empty() ? 1 : _Terrain[pos.second * _GridSizeX + pos.first];
+}
+
+void MapGrid::ClearTerrain(void)
+{
+	_Terrain.clear();
+	_Terrain.shrink_to_fit();
+	_TerrainMinCost = 1;
+}
+
+void MapGrid::SetCellTerrain(uint32_t idx, uint8_t cost)
+{
+	// start and target are never blocked, the same as with ToggleObstacle
+	if (cost == 0 && (idx == _Start || idx == _Target)) cost = 1;
+	_Terrain[idx] = cost;
+	SetCellObstacle(idx, cost == 0);
+	if (cost != 0 && cost < _TerrainMinCost) _TerrainMinCost = cost;
+}
+
+bool MapGrid::WriteCellTerrain(uint32_t idx, uint8_t cost, bool& freed)
+{
+	if (cost == 0 && (idx == _Start || idx == _Target)) cost = 1;
+	_Terrain[idx] = cost;
+	int x = idx % _GridSizeX;
+	int y = idx / _GridSizeX;
+	if (_Obstacles.Test(x, y) == (cost == 0)) return false;
+	_Obstacles.Set(x, y, cost == 0);
+	if (cost != 0) freed = true;
+	return true;
+}
+
+void MapGrid::ApplyFullMapChange(bool cellsFreed)
+{
+	// one version for the whole change, the entry only keeps the ring in step and is never read
+	if (_Changes.size() < CHANGE_HISTORY) _Changes.push_back(0);
+	else _Changes[_Version % CHANGE_HISTORY] = 0;
+	_Version++;
+	_FullChangeVersion = _Version;
+	// rebuilding once is far cheaper than repairing the layers cell by cell
+	if (_JpsPlus.IsBuilt()) _JpsPlus.Build(_Obstacles);
+	if (_Components.IsBuilt()) SweepComponents();
+	if (cellsFreed && _Landmarks.IsBuilt()) _Landmarks.Clear();
+}
+
+void MapGrid::UpdateTerrainMinCost(void)
+{
+	// blocked cells may keep an old cost, counting them only makes the scale lower
+	uint8_t lowest = 0xFF;
+	for (uint8_t cost : _Terrain) {
+		if (cost != 0 && cost < lowest) lowest = cost;
 	}
+	_TerrainMinCost = lowest;
 }
 
-float MapGrid::Distance(Node* a, Node* b)
+uint64_t MapGrid::GetVersion(void) const
 {
-	return sqrtf(((float)a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y));
+	return _Version;
 }
 
-float MapGrid::Heuristic(Node* a, Node* b)
+bool MapGrid::GetChangedCells(uint64_t sinceVersion, std::vector<uint32_t>& cells) const
 {
-	return Distance(a, b);
+	cells.clear();
+	if (sinceVersion > _Version || sinceVersion < _FullChangeVersion || _Version - sinceVersion > _Changes.size()) return false;
+	for (uint64_t version = sinceVersion; version < _Version; version++) {
+		cells.push_back(_Changes[version % CHANGE_HISTORY]);
+	}
+	return true;
 }
 
-std::vector<MapGrid::Node*> MapGrid::Find_AStar_Path()
+int MapGrid::GetNeighbourCount(void) const
 {
-	ResetMap();
-	std::vector<Node*> path;
-	Node* current = _Start;
-	_Start->localGoal = 0.0f;
-	_Start->globalGoal = Heuristic(_Start, _Target);
-	// declare a list for non tested _Nodes and put start node to list initially 
-	std::list<Node*> _NodesToBeTested;
-	_NodesToBeTested.push_back(_Start);
-
-	while (!_NodesToBeTested.empty() && current != _Target) {
-		// sort _Nodes to be tested by global value (lowest first!)
-		_NodesToBeTested.sort([](const Node* a, const Node* b){ return a->globalGoal < b->globalGoal; });
-
-		// after the sort if the front of the list is already visited remove it
-		while (!_NodesToBeTested.empty() && _NodesToBeTested.front()->isVisited) {
-			_NodesToBeTested.pop_front();
+	return _NeighbourCount;
+}
+
+// FNV-1a over the grid size, the move rules and the obstacle bits
+uint64_t MapGrid::GetFingerprint(void) const
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto mix = [&hash](uint64_t value) {
+		for (int byte = 0; byte < 8; byte++) {
+			hash ^= (value >> (byte * 8)) & 0xFF;
+			hash *= 0x100000001B3ull;
 		}
+	};
+	mix((uint64_t)_GridSizeX);
+	mix((uint64_t)_GridSizeY);
+	mix((uint64_t)_NeighbourCount);
+	mix((uint64_t)_CornerCutting);
+	int rowWords = _Obstacles.GetRowWordCount();
+	int lastBits = _GridSizeX & 63;
+	for (int y = 0; y < _GridSizeY; y++) {
+		for (int word = 0; word < rowWords; word++) {
+			uint64_t bits = _Obstacles.GetRowWord(y, word);
+			if (word == rowWords - 1 && lastBits != 0) bits &= (1ull << lastBits) - 1; // padding bits
+			mix(bits);
+		}
+	}
+	return hash;
+}
+
+void MapGrid::BuildJpsPlusTable(int threadCount)
+{
+	_JpsPlus.Build(_Obstacles, threadCount);
+}
 
-		// if there is no node to be tested break
-		if (_NodesToBeTested.empty()) break;
+void MapGrid::BuildLandmarks(int landmarkCount, int threadCount)
+{
+	_Landmarks.Build(*this, landmarkCount, threadCount);
+}
 
-		current = _NodesToBeTested.front();
-		current->isVisited = true;
+bool MapGrid::SaveLandmarks(const char* fileName) const
+{
+	return _Landmarks.Save(fileName, *this);
+}
 
-		// check neighbours of current node
-		for (auto neighbourNode : current->neighbours) {
-			if (!neighbourNode->isVisited && !neighbourNode->isObstacle) {
-				_NodesToBeTested.push_back(neighbourNode);
-			}
+bool MapGrid::LoadLandmarks(const char* fileName)
+{
+	return _Landmarks.Load(fileName, *this);
+}
 
-			if ((current->localGoal + Distance(current, neighbourNode)) < neighbourNode->localGoal) {
-				neighbourNode->parent = current;
-				neighbourNode->localGoal = current->localGoal + Distance(current, neighbourNode);
-				neighbourNode->globalGoal = neighbourNode->localGoal + Heuristic(neighbourNode, _Target);
+const LandmarkTable& MapGrid::GetLandmarks(void) const
+{
+	return _Landmarks;
+}
+
+void MapGrid::ResetMap()
+{
+	int cellCount = _GridSizeX * _GridSizeY;
+	if (_Obstacles.GetSizeX() != _GridSizeX || _Obstacles.GetSizeY() != _GridSizeY) {
+		_Obstacles.Resize(_GridSizeX, _GridSizeY); // keep the obstacle value for new calculation
+	}
+	// search data is reallocated and invalidated, visited cells are not shown anymore
+	_Search = SearchContext<Cost>();
+	_Search.Prepare(cellCount);
+}
+
+std::vector<MapGrid::GridPos> MapGrid::Find_AStar_Path()
+{
+	return Find_AStar_Path(_Search);
+}
+
+std::vector<MapGrid::GridPos> MapGrid::Find_ALT_Path()
+{
+	return Find_ALT_Path(_Search);
+}
+
+bool MapGrid::IsQueryCell(GridPos pos, uint32_t& idx) const
+{
+	if (_Obstacles.Test(pos.first, pos.second)) return false; // outside of the grid reads as blocked too
+	idx = pos.second * _GridSizeX + pos.first;
+	return true;
+}
+
+template <typename CostT, typename OpenListT>
+bool MapGrid::Search(Algorithm algorithm, GridPos startPos, GridPos targetPos, SearchContext<CostT, OpenListT>& context) const
+{
+	context.BeginSearch(_GridSizeX * _GridSizeY);
+	if (!IsQueryCell(startPos, context.start) || !IsQueryCell(targetPos, context.target)) {
+		context.start = context.target = 0; // nothing is visited, so there is no path
+		return false;
+	}
+	// cells in different regions, nothing is visited
+	if (_Components.IsBuilt() && !_Components.AreConnected(context.start, context.target)) return false;
+
+	if (algorithm == Algorithm::JPSPlus && !_JpsPlus.IsBuilt()) algorithm = Algorithm::JPS;
+	if (algorithm == Algorithm::JPS && !UsesJumpRules()) algorithm = Algorithm::AStar;
+	// jump points skip over cells, the terrain costs of the cells in between would be lost
+	if ((algorithm == Algorithm::JPS || algorithm == Algorithm::JPSPlus) && HasTerrain()) algorithm = Algorithm::AStar;
+	// landmark distances are fixed point, floating point costs would not match them exactly
+	if (algorithm == Algorithm::ALT && (!_Landmarks.IsBuilt() || !std::is_integral<CostT>::value)) algorithm = Algorithm::AStar;
+	int targetX = context.target % _GridSizeX;
+	int targetY = context.target / _GridSizeX;
+	switch (algorithm) {
+	case Algorithm::AStar:
+		RunAStar(context, [this, targetX, targetY](int x, int y) { return Heuristic<CostT>(x, y, targetX, targetY); });
+		break;
+	case Algorithm::JPS: RunJPS(context); break;
+	case Algorithm::JPSPlus: RunJPSPlus(context); break;
+	case Algorithm::ALT:
+		RunAStar(context, [this, targetX, targetY](int x, int y) { return LandmarkHeuristic<CostT>(x, y, targetX, targetY); });
+		break;
+	}
+	return context.IsCellVisited(context.target);
+}
+
+template <typename CostT, typename OpenListT>
+MapGrid::SearchStatus MapGrid::BeginSlicedSearch(GridPos startPos, GridPos targetPos, SearchContext<CostT, OpenListT>& context) const
+{
+	// same checks as Search, a refused query leaves the open list empty and nothing visited
+	context.BeginSearch(_GridSizeX * _GridSizeY);
+	if (!IsQueryCell(startPos, context.start) || !IsQueryCell(targetPos, context.target)) {
+		context.start = context.target = 0;
+		return SearchStatus::NoPath;
+	}
+	if (_Components.IsBuilt() && !_Components.AreConnected(context.start, context.target)) return SearchStatus::NoPath;
+	int targetX = context.target % _GridSizeX;
+	int targetY = context.target / _GridSizeX;
+	OpenStartCell(context, [this, targetX, targetY](int x, int y) { return Heuristic<CostT>(x, y, targetX, targetY); });
+	return SearchStatus::Running;
+}
+
+template <typename CostT, typename OpenListT>
+MapGrid::SearchStatus MapGrid::StepSlicedSearch(SearchContext<CostT, OpenListT>& context, int maxExpansions) const
+{
+	SearchStatus status = GetSearchStatus(context);
+	if (status != SearchStatus::Running) return status;
+	int targetX = context.target % _GridSizeX;
+	int targetY = context.target / _GridSizeX;
+	ExpandAStar(context, [this, targetX, targetY](int x, int y) { return Heuristic<CostT>(x, y, targetX, targetY); }, maxExpansions);
+	return GetSearchStatus(context);
+}
+
+template <typename CostT, typename OpenListT>
+MapGrid::SearchStatus MapGrid::GetSearchStatus(const SearchContext<CostT, OpenListT>& context) const
+{
+	// the search stops at the target, so everything follows from the context
+	if (context.IsCellVisited(context.target)) return SearchStatus::Found;
+	return context.openList.Empty() ? SearchStatus::NoPath : SearchStatus::Running;
+}
+
+template <typename CostT, typename OpenListT, typename HeuristicFunc>
+void MapGrid::RunAStar(SearchContext<CostT, OpenListT>& context, HeuristicFunc heuristic) const
+{
+	OpenStartCell(context, heuristic);
+	ExpandAStar(context, heuristic, std::numeric_limits<int>::max());
+}
+
+template <typename CostT, typename OpenListT, typename HeuristicFunc>
+void MapGrid::OpenStartCell(SearchContext<CostT, OpenListT>& context, HeuristicFunc heuristic) const
+{
+	const uint32_t start = context.start;
+	context.TouchCell(start);
+	context.localGoal[start] = 0;
+	// open list keeps every cell at most once, improved cells get their key decreased
+	context.OpenCell(start, heuristic(start % _GridSizeX, start / _GridSizeX));
+}
+
+template <typename CostT, typename OpenListT, typename HeuristicFunc>
+void MapGrid::ExpandAStar(SearchContext<CostT, OpenListT>& context, HeuristicFunc heuristic, int maxExpansions) const
+{
+	const uint32_t target = context.target;
+	// step costs are computed once, integer costs make them exact
+	const CostT straight = CostTraits<CostT>::Straight();
+	const CostT diagonal = CostTraits<CostT>::Diagonal();
+	const CostT stepCost[8] = { straight, straight, straight, straight, diagonal, diagonal, diagonal, diagonal };
+	// with terrain a move costs half of its step per terrain cost unit of each of its two cells,
+	// the halves of the fixed point steps are exact
+	const CostT halfStep[8] = { straight / 2, straight / 2, straight / 2, straight / 2, diagonal / 2, diagonal / 2, diagonal / 2, diagonal / 2 };
+	const uint8_t* terrain = _Terrain.empty() ? nullptr : _Terrain.data();
+
+	for (int expansions = 0; expansions < maxExpansions && !context.openList.Empty(); expansions++) {
+		// pop the cell with the lowest global goal
+		uint32_t current = context.openList.Pop();
+		context.MarkVisited(current);
+		if (current == target) break;
+
+		// check neighbours of current cell, they are generated from the direction table
+		int cx = current % _GridSizeX;
+		int cy = current / _GridSizeX;
+		for (int dir = 0; dir < _NeighbourCount; dir++) {
+			int nx = cx + DIR_X[dir];
+			int ny = cy + DIR_Y[dir];
+			// cells outside of the grid read as obstacles
+			if (_Obstacles.Test(nx, ny)) continue;
+			if (dir >= 4 && !IsDiagonalMoveAllowed(cx, cy, nx, ny)) continue;
+
+			uint32_t neighbour = ny * _GridSizeX + nx;
+			if (context.IsCellVisited(neighbour)) continue;
+			context.TouchCell(neighbour);
+
+			CostT step = terrain ? halfStep[dir] * (CostT)(terrain[current] + terrain[neighbour]) : stepCost[dir];
+			// a cost past the range of CostT saturates at infinity and never opens the cell, the
+			// search reports no path instead of a wrapped, wrong one
+			CostT localGoal = CostTraits<CostT>::Add(context.localGoal[current], step);
+			if (localGoal < context.localGoal[neighbour]) {
+				context.parent[neighbour] = current;
+				context.localGoal[neighbour] = localGoal;
+				context.OpenCell(neighbour, CostTraits<CostT>::Add(localGoal, heuristic(nx, ny)));
 			}
 		}
 	}
+}
 
-	// assemble the path from target to start then reverse the vector
-	if (_Target->isVisited) {
-		MapGrid::Node* pathNode = _Target;
-		while (pathNode != _Start) {
-			path.push_back(pathNode);
-			pathNode = pathNode->parent;
+/**
+  * @brief  Calls visit(index, cell, direction) for every cell of the last path from the target
+  *         back to the start, index is the position of the cell on the path. Parents may be
+  *         further than one cell away (jump points), the cells in between are visited too.
+  *         direction is the code of the move that enters the cell, -1 for the start.
+  * @retval number of cells on the path, 0 if there is no path
+  */
+template <typename CostT, typename OpenListT, typename VisitFunc>
+size_t MapGrid::WalkPathBackward(const SearchContext<CostT, OpenListT>& context, VisitFunc visit) const
+{
+	if (!context.IsCellVisited(context.target)) return 0;
+
+	// every parent link covers max(|dx|, |dy|) moves
+	size_t cellCount = 1;
+	for (uint32_t cell = context.target; cell != context.start; cell = context.parent[cell]) {
+		uint32_t parentCell = context.parent[cell];
+		cellCount += std::max(std::abs((int)(cell % _GridSizeX) - (int)(parentCell % _GridSizeX)),
+			std::abs((int)(cell / _GridSizeX) - (int)(parentCell / _GridSizeX)));
+	}
+
+	size_t index = cellCount;
+	for (uint32_t cell = context.target; cell != context.start; cell = context.parent[cell]) {
+		uint32_t parentCell = context.parent[cell];
+		int x = cell % _GridSizeX;
+		int y = cell / _GridSizeX;
+		int dx = ((int)(parentCell % _GridSizeX) > x) - ((int)(parentCell % _GridSizeX) < x);
+		int dy = ((int)(parentCell / _GridSizeX) > y) - ((int)(parentCell / _GridSizeX) < y);
+		int direction = JpsPlusDirection(-dx, -dy); // same order as the direction table
+		while ((uint32_t)(y * _GridSizeX + x) != parentCell) {
+			visit(--index, (uint32_t)(y * _GridSizeX + x), direction);
+			x += dx;
+			y += dy;
 		}
-		path.push_back(_Start);
-		std::reverse(path.begin(), path.end());
 	}
+	visit(--index, context.start, -1);
+	return cellCount;
+}
+
+template <typename CostT, typename OpenListT>
+void MapGrid::GetPath(const SearchContext<CostT, OpenListT>& context, std::vector<GridPos>& path) const
+{
+	path.clear();
+	if (!context.IsCellVisited(context.target)) return;
+	path.resize(WalkPathBackward(context, [](size_t, uint32_t, int) {}));
+	WalkPathBackward(context, [&](size_t index, uint32_t cell, int) {
+		path[index] = GridPos(cell % _GridSizeX, cell / _GridSizeX);
+	});
+}
+
+template <typename CostT, typename OpenListT>
+size_t MapGrid::GetPathCells(const SearchContext<CostT, OpenListT>& context, Span<uint32_t> cells) const
+{
+	size_t cellCount = WalkPathBackward(context, [](size_t, uint32_t, int) {});
+	if (cellCount == 0 || cells.size() < cellCount) return cellCount;
+	WalkPathBackward(context, [&](size_t index, uint32_t cell, int) {
+		cells[index] = cell;
+	});
+	return cellCount;
+}
 
-	return path;
+template <typename CostT, typename OpenListT>
+Span<const uint32_t> MapGrid::GetPathCells(SearchContext<CostT, OpenListT>& context) const
+{
+	size_t cellCount = GetPathCells(context, Span<uint32_t>());
+	context.pathCells.resize(cellCount); // only allocates when a longer path than before is found
+	GetPathCells(context, Span<uint32_t>(context.pathCells));
+	return Span<const uint32_t>(context.pathCells.data(), cellCount);
+}
+
+template <typename CostT, typename OpenListT>
+size_t MapGrid::GetPathDirections(const SearchContext<CostT, OpenListT>& context, Span<uint8_t> bytes, size_t& moveCount) const
+{
+	size_t cellCount = WalkPathBackward(context, [](size_t, uint32_t, int) {});
+	moveCount = cellCount > 0 ? cellCount - 1 : 0;
+	size_t byteCount = (moveCount * 3 + 7) / 8;
+	if (cellCount == 0 || bytes.size() < byteCount) return byteCount;
+
+	std::fill(bytes.begin(), bytes.begin() + byteCount, (uint8_t)0);
+	WalkPathBackward(context, [&](size_t index, uint32_t, int direction) {
+		if (direction < 0) return;
+		// the move entering cell i is move i - 1, a code may cross a byte boundary
+		size_t bit = (index - 1) * 3;
+		unsigned int code = (unsigned int)direction << (bit & 7);
+		bytes[bit >> 3] |= (uint8_t)code;
+		if (code > 0xFF) bytes[(bit >> 3) + 1] |= (uint8_t)(code >> 8);
+	});
+	return byteCount;
+}
+
+MapGrid::GridPos MapGrid::GetDirectionOffset(int directionCode)
+{
+	return GridPos(DIR_X[directionCode & 7], DIR_Y[directionCode & 7]);
+}
+
+#define INSTANTIATE_SEARCH(CONTEXT) \
+	template bool MapGrid::Search(Algorithm algorithm, GridPos startPos, GridPos targetPos, CONTEXT& context) const; \
+	template void MapGrid::GetPath(const CONTEXT& context, std::vector<GridPos>& path) const; \
+	template size_t MapGrid::GetPathCells(const CONTEXT& context, Span<uint32_t> cells) const; \
+	template Span<const uint32_t> MapGrid::GetPathCells(CONTEXT& context) const; \
+	template size_t MapGrid::GetPathDirections(const CONTEXT& context, Span<uint8_t> bytes, size_t& moveCount) const; \
+	template MapGrid::SearchStatus MapGrid::BeginSlicedSearch(GridPos startPos, GridPos targetPos, CONTEXT& context) const; \
+	template MapGrid::SearchStatus MapGrid::StepSlicedSearch(CONTEXT& context, int maxExpansions) const; \
+	template MapGrid::SearchStatus MapGrid::GetSearchStatus(const CONTEXT& context) const;
+FOR_EACH_SEARCH_CONTEXT(INSTANTIATE_SEARCH)
+
+int MapGrid::GridView::GetCellCount(void) const
+{
+	return _Map._GridSizeX * _Map._GridSizeY;
+}
+
+MapGrid::GridPos MapGrid::GridView::GetCellPos(int idx) const
+{
+	return GridPos(idx % _Map._GridSizeX, idx / _Map._GridSizeX);
+}
+
+bool MapGrid::GridView::IsObstacle(int idx) const
+{
+	return _Map._Obstacles.Test(idx % _Map._GridSizeX, idx / _Map._GridSizeX);
+}
+
+bool MapGrid::GridView::IsVisited(int idx) const
+{
+	return _Map._Search.IsCellVisited(idx);
+}
+
+bool MapGrid::GridView::IsStart(int idx) const
+{
+	return (uint32_t)idx == _Map._Start;
+}
+
+bool MapGrid::GridView::IsTarget(int idx) const
+{
+	return (uint32_t)idx == _Map._Target;
 }
 
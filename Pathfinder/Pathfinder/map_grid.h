@@ -11,49 +11,280 @@
 #define MAP_GRID_H
 
 #include<vector>
+#include <cstdint>
+#include "indexed_heap.h"
+#include "cost_traits.h"
+#include "search_context.h"
+#include "span.h"
+#include "obstacle_bitmap.h"
+#include "jps_plus.h"
+#include "component_labels.h"
+#include "landmark_table.h"
 
 class MapGrid {
 public:
-	struct Node {
-	public:
-		bool isObstacle = false;
-		bool isVisited = false;
-		float globalGoal = INFINITY;
-		float localGoal = INFINITY;
-		int x = -1;
-		int y = -1;
-		std::vector<Node*> neighbours;
-		Node* parent = nullptr;
-	};
-
 	typedef std::pair<int, int> GridPos;
 	typedef std::pair<int, int> GridSize;
 
+	// neighbour policy of the grid
+	enum class Connectivity {
+		Four,
+		Eight
+	};
+
+	// when a diagonal move may pass the corner of an obstacle on 8 connected grids
+	enum class CornerCutting {
+		Never,         // both straight cells next to the move must be free
+		IfOneSideFree, // at least one of them must be free
+		Always         // diagonal moves ignore the cells next to them
+	};
+
+	// default cost type of the searches, fixed point with COST_STRAIGHT being one cell.
+	// Integer costs keep the results identical on every compiler, other cost types
+	// can be used through the search functions that take a SearchContext
+	typedef uint32_t Cost;
+	static const Cost COST_STRAIGHT = 1000;
+	static const Cost COST_DIAGONAL = 1414; // sqrt(2) cells
+	static const Cost COST_INFINITY = 0xFFFFFFFFu;
+
+	static const uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+	// read only access to the cells, cell indices are row major (y * width + x)
+	class GridView {
+	public:
+		GridView(const MapGrid& map) : _Map(map) {}
+		int GetCellCount(void) const;
+		GridPos GetCellPos(int idx) const;
+		bool IsObstacle(int idx) const;
+		bool IsVisited(int idx) const;
+		bool IsStart(int idx) const;
+		bool IsTarget(int idx) const;
+
+	private:
+		const MapGrid& _Map;
+	};
+
 	// public funcrtion prototypes
-	MapGrid(int x, int y);
-	Node* GetTargetNode(void);
-	Node* GetStartNode(void);
-	GridPos GetTargetPos(void);
+	MapGrid(int x, int y, Connectivity connectivity = Connectivity::Four, CornerCutting cornerCutting = CornerCutting::Never);
+	GridPos GetTargetPos(void) const;
 	void SetTargetPos(GridPos targetPos);
-	GridPos GetStartPos(void);
+	GridPos GetStartPos(void) const;
 	void SetStartPos(GridPos startPos);
 	void ResetMap();
 	void ToggleObstacle(GridPos obstaclePos);
-	std::vector<Node*> Find_AStar_Path();
-	GridSize GetGridSize(void);
-	Node* GetGridArray(void);
+	std::vector<GridPos> Find_AStar_Path();
+	std::vector<GridPos> Find_JPS_Path(); // Jump Point Search, falls back to A* unless the grid is 8 connected without corner cutting
+	void BuildJpsPlusTable(int threadCount = 0); // 0 means all cores, not built on maps with a side over JpsPlusTable::MAX_SIZE
+	std::vector<GridPos> Find_JPSPlus_Path(); // JPS+ table lookups, falls back to JPS if the table is not built
+	// labels the connected regions of free cells, after that searches between two regions return
+	// at once and ToggleObstacle keeps the labels up to date
+	void BuildComponentLabels(void);
+	bool AreConnected(GridPos a, GridPos b) const; // false for blocked cells, true for free cells while the labels are not built
+	// ALT landmark distances (0 threads means all cores). Freeing a cell drops the table, the bounds
+	// would not hold anymore. Blocked cells only make paths longer, so the table stays and its bounds
+	// get looser. The file only loads on a map with the same obstacles and move rules
+	void BuildLandmarks(int landmarkCount = 16, int threadCount = 0);
+	bool SaveLandmarks(const char* fileName) const;
+	bool LoadLandmarks(const char* fileName);
+	const LandmarkTable& GetLandmarks(void) const;
+	std::vector<GridPos> Find_ALT_Path(); // A* with the landmark heuristic, falls back to A* if the table is not built
+	// terrain costs, one byte per cell (0 blocks the cell, like an obstacle). A move costs its straight
+	// or diagonal cost times the mean of the costs of its two cells, the heuristic is scaled by the
+	// lowest cost. Without a layer every free cell costs 1. The searches of the map read the layer,
+	// JPS and JPS+ fall back to A* while it is set. The planners with their own state keep uniform
+	// costs. A uint32_t path cost holds about 4.3 million straight moves at terrain cost 1, but only
+	// about 16800 straight or 11900 diagonal moves at cost 255. Longer paths saturate and are
+	// reported as no path, use a uint64_t context for high costs on large maps
+	bool LoadTerrain(Span<const uint8_t> costs); // row major, one byte per cell, false if the size does not match
+	bool UpdateTerrain(GridPos origin, int width, int height, Span<const uint8_t> costs); // row major rectangle, false if it leaves the grid
+	void SetTerrainCost(GridPos pos, uint8_t cost);
+	uint8_t GetTerrainCost(GridPos pos) const; // 0 for blocked cells
+	void ClearTerrain(void); // every free cell costs 1 again, the obstacles stay
+	bool HasTerrain(void) const { return !_Terrain.empty(); }
+	uint8_t GetMinTerrainCost(void) const { return _TerrainMinCost; } // never above the cost of a free cell
+
+	// algorithms of the context searches. JPSPlus falls back to JPS while the table is not
+	// built and JPS falls back to AStar unless the grid is 8 connected without corner cutting.
+	// ALT falls back to AStar while the landmarks are not built and for floating point costs
+	enum class Algorithm {
+		AStar,
+		JPS,
+		JPSPlus,
+		ALT
+	};
+
+	// queries that keep all of their state in the caller's context. They do not change the map,
+	// so any number of threads can run them at the same time, each with its own context, as
+	// long as nobody edits the map meanwhile. Instantiated for uint32_t, uint64_t, float and
+	// double costs with a heap open list and for the integer costs with a bucket queue open list.
+	// Start or target outside of the grid or on an obstacle give an empty path
+	template <typename CostT, typename OpenListT> bool Search(Algorithm algorithm, GridPos start, GridPos target, SearchContext<CostT, OpenListT>& context) const; // true if a path is found
+	template <typename CostT, typename OpenListT> void GetPath(const SearchContext<CostT, OpenListT>& context, std::vector<GridPos>& path) const; // path of the last search, reuses the vector's storage
+	// allocation free path output. The cells (y * width + x) or the packed moves are only
+	// written if the buffer is large enough, the return value is the size needed (0 if there
+	// is no path), so a too small buffer can be grown and filled again without a new search
+	template <typename CostT, typename OpenListT> size_t GetPathCells(const SearchContext<CostT, OpenListT>& context, Span<uint32_t> cells) const;
+	// 3 bit direction code per move, move i is in bits [3i, 3i + 3) of the little endian byte
+	// stream. Returns the bytes needed, moveCount is set to the number of moves
+	template <typename CostT, typename OpenListT> size_t GetPathDirections(const SearchContext<CostT, OpenListT>& context, Span<uint8_t> bytes, size_t& moveCount) const;
+	// path cells in the context's own storage, valid until the next search with the context
+	template <typename CostT, typename OpenListT> Span<const uint32_t> GetPathCells(SearchContext<CostT, OpenListT>& context) const;
+	// time sliced A*. BeginSlicedSearch only opens the start cell, every StepSlicedSearch expands
+	// at most maxExpansions cells and carries on where the last step stopped, all of the state is
+	// in the context. The map must not change between the steps. The result is read with the
+	// path functions above once the status is Found
+	enum class SearchStatus {
+		Running,
+		Found,
+		NoPath
+	};
+	template <typename CostT, typename OpenListT> SearchStatus BeginSlicedSearch(GridPos start, GridPos target, SearchContext<CostT, OpenListT>& context) const;
+	template <typename CostT, typename OpenListT> SearchStatus StepSlicedSearch(SearchContext<CostT, OpenListT>& context, int maxExpansions) const;
+	template <typename CostT, typename OpenListT> SearchStatus GetSearchStatus(const SearchContext<CostT, OpenListT>& context) const;
+	static GridPos GetDirectionOffset(int directionCode); // (dx, dy) of a packed direction code
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_AStar_Path(GridPos start, GridPos target, SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::AStar, start, target, context);
+	}
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_JPS_Path(GridPos start, GridPos target, SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::JPS, start, target, context);
+	}
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_JPSPlus_Path(GridPos start, GridPos target, SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::JPSPlus, start, target, context);
+	}
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_ALT_Path(GridPos start, GridPos target, SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::ALT, start, target, context);
+	}
+	// same queries between the start and target of the map
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_AStar_Path(SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::AStar, GetStartPos(), GetTargetPos(), context);
+	}
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_JPS_Path(SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::JPS, GetStartPos(), GetTargetPos(), context);
+	}
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_JPSPlus_Path(SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::JPSPlus, GetStartPos(), GetTargetPos(), context);
+	}
+	template <typename CostT, typename OpenListT> std::vector<GridPos> Find_ALT_Path(SearchContext<CostT, OpenListT>& context) const
+	{
+		return FindPath(Algorithm::ALT, GetStartPos(), GetTargetPos(), context);
+	}
+
+	GridSize GetGridSize(void) const;
+	GridView GetGridView(void) const;
+	const ObstacleBitmap& GetObstacleBitmap(void) const;
+	int GetExpandedNodeCount(void) const;
+	Connectivity GetConnectivity(void) const;
+	CornerCutting GetCornerCutting(void) const;
+	Cost GetLastPathCost(void) const; // cost of the last path found or COST_INFINITY
+
+	// move rules and edit history for the planners that keep their own state between queries
+	int GetNeighbourCount(void) const; // 4 or 8, the first direction codes of GetDirectionOffset
+	bool IsMoveAllowed(int x, int y, int dx, int dy) const
+	{
+		int nx = x + dx;
+		int ny = y + dy;
+		if (_Obstacles.Test(nx, ny)) return false;
+		return dx == 0 || dy == 0 || IsDiagonalMoveAllowed(x, y, nx, ny);
+	}
+	uint64_t GetVersion(void) const; // incremented by every obstacle change
+	// cells changed after the given version, oldest first. False if the history does not go back that far or
+	// a bulk terrain load changed the obstacles since, the caller has to start over then
+	bool GetChangedCells(uint64_t sinceVersion, std::vector<uint32_t>& cells) const;
+	uint64_t GetFingerprint(void) const; // hash of the size, the move rules and the obstacles, ties preprocessed files to a map
 
 private:
 	// private variables
 	int _GridSizeX = 0;
 	int _GridSizeY = 0;
-	Node* _Nodes = nullptr;
-	Node* _Target = nullptr;
-	Node* _Start = nullptr;
+	Connectivity _Connectivity = Connectivity::Four;
+	CornerCutting _CornerCutting = CornerCutting::Never;
+	int _NeighbourCount = 4; // number of entries of the direction table used by the search
+	uint32_t _Target = 0;
+	uint32_t _Start = 0;
+	ObstacleBitmap _Obstacles; // one bit per cell, 64 cells per word
+	std::vector<uint8_t> _Terrain; // cost of every cell, row major, empty while every free cell costs 1
+	uint8_t _TerrainMinCost = 1;
+	JpsPlusTable _JpsPlus; // empty until BuildJpsPlusTable is called, repaired on every obstacle change
+	ComponentLabels _Components; // empty until BuildComponentLabels is called, updated on every obstacle change
+	LandmarkTable _Landmarks; // empty until BuildLandmarks or LoadLandmarks is called, dropped when a cell is freed
+
+	uint64_t _Version = 0;
+	static const size_t CHANGE_HISTORY = 4096;
+	std::vector<uint32_t> _Changes; // ring of the last changed cells, version v is at (v - 1) % CHANGE_HISTORY
+	uint64_t _FullChangeVersion = 0; // version of the last bulk change, changes before it are not listed cell by cell
+
+	SearchContext<Cost> _Search; // search data of the searches without a caller context
 
 	// private function prototypes
-	float Distance(Node* a, Node* b);
-	float Heuristic(Node* a, Node* b);
+	void SetCellObstacle(uint32_t idx, bool blocked);
+	void SetCellTerrain(uint32_t idx, uint8_t cost);
+	bool WriteCellTerrain(uint32_t idx, uint8_t cost, bool& freed); // cost and obstacle bit only, true if the bit changed
+	void ApplyFullMapChange(bool cellsFreed);
+	void UpdateTerrainMinCost(void);
+	bool IsQueryCell(GridPos pos, uint32_t& idx) const;
+	template <typename CostT, typename OpenListT, typename HeuristicFunc> void RunAStar(SearchContext<CostT, OpenListT>& context, HeuristicFunc heuristic) const;
+	template <typename CostT, typename OpenListT, typename HeuristicFunc> void OpenStartCell(SearchContext<CostT, OpenListT>& context, HeuristicFunc heuristic) const;
+	template <typename CostT, typename OpenListT, typename HeuristicFunc> void ExpandAStar(SearchContext<CostT, OpenListT>& context, HeuristicFunc heuristic, int maxExpansions) const;
+	template <typename CostT, typename OpenListT> void RunJPS(SearchContext<CostT, OpenListT>& context) const;
+	template <typename CostT, typename OpenListT> void RunJPSPlus(SearchContext<CostT, OpenListT>& context) const;
+	template <typename CostT, typename OpenListT, typename JumpFunc> void RunJumpSearch(SearchContext<CostT, OpenListT>& context, JumpFunc jump) const;
+	template <typename CostT, typename OpenListT, typename VisitFunc> size_t WalkPathBackward(const SearchContext<CostT, OpenListT>& context, VisitFunc visit) const;
+	bool UsesJumpRules(void) const;
+	void SweepComponents(void);
+	void FreeComponentCell(int x, int y);
+	void BlockComponentCell(int x, int y);
+	bool MaySplitComponent(int x, int y) const;
+
+	template <typename CostT, typename OpenListT>
+	std::vector<GridPos> FindPath(Algorithm algorithm, GridPos start, GridPos target, SearchContext<CostT, OpenListT>& context) const
+	{
+		std::vector<GridPos> path;
+		if (Search(algorithm, start, target, context)) GetPath(context, path);
+		return path;
+	}
+
+	// exact cost between two cells on a straight or diagonal line, manhattan on 4 and octile on 8 connected grids
+	template <typename CostT>
+	CostT Distance(int ax, int ay, int bx, int by) const
+	{
+		if (_Connectivity == Connectivity::Four) return ManhattanCost<CostT>(ax - bx, ay - by);
+		return OctileCost<CostT>(ax - bx, ay - by);
+	}
+
+	// every move costs at least its distance times the lowest terrain cost
+	template <typename CostT>
+	CostT Heuristic(int x, int y, int targetX, int targetY) const
+	{
+		return Distance<CostT>(x, y, targetX, targetY) * (CostT)_TerrainMinCost;
+	}
+
+	// largest of the landmark bounds and the plain heuristic, both are consistent so the maximum is too
+	template <typename CostT>
+	CostT LandmarkHeuristic(int x, int y, int targetX, int targetY) const
+	{
+		// landmark distances are uniform cost distances, the terrain scales them like the plain heuristic
+		CostT bound = (CostT)_Landmarks.LowerBound(y * _GridSizeX + x, targetY * _GridSizeX + targetX) * (CostT)_TerrainMinCost;
+		return std::max(bound, Heuristic<CostT>(x, y, targetX, targetY));
+	}
+
+	// checks the corner cutting rule, (x, y) and (nx, ny) are diagonal neighbours
+	bool IsDiagonalMoveAllowed(int x, int y, int nx, int ny) const
+	{
+		bool blockedX = _Obstacles.Test(nx, y);
+		bool blockedY = _Obstacles.Test(x, ny);
+		switch (_CornerCutting) {
+		case CornerCutting::Never: return !blockedX && !blockedY;
+		case CornerCutting::IfOneSideFree: return !blockedX || !blockedY;
+		default: return true;
+		}
+	}
 };
 
 #endif
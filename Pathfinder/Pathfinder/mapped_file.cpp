@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    mapped_file.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the implementation of the memory mapped file.
+  ******************************************************************************
+  */
+#include "mapped_file.h"
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const char* fileName)
+{
+	Close();
+	HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		return false;
+	}
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	_File = file;
+	_Mapping = mapping;
+	_Data = (const uint8_t*)data;
+	_Size = (size_t)size.QuadPart;
+	return true;
+}
+
+void MappedFile::Close(void)
+{
+	if (_Data) UnmapViewOfFile(_Data);
+	if (_Mapping) CloseHandle((HANDLE)_Mapping);
+	if (_File) CloseHandle((HANDLE)_File);
+	_Data = nullptr;
+	_Mapping = nullptr;
+	_File = nullptr;
+	_Size = 0;
+}
+
+#else
+
+bool MappedFile::Open(const char* fileName)
+{
+	Close();
+	int file = open(fileName, O_RDONLY);
+	if (file < 0) return false;
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0) {
+		close(file);
+		return false;
+	}
+	void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+	if (data == MAP_FAILED) {
+		close(file);
+		return false;
+	}
+	_File = file;
+	_Data = (const uint8_t*)data;
+	_Size = (size_t)info.st_size;
+	return true;
+}
+
+void MappedFile::Close(void)
+{
+	if (_Data) munmap((void*)_Data, _Size);
+	if (_File >= 0) close(_File);
+	_Data = nullptr;
+	_File = -1;
+	_Size = 0;
+}
+
+#endif
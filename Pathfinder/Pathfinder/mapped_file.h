@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    mapped_file.h
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains a read only memory mapped file. Opening maps the
+  *          whole file without reading it, pages are loaded by the system the
+  *          first time they are touched, so big preprocessed tables are ready
+  *          at once.
+  ******************************************************************************
+  */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstdint>
+#include <cstddef>
+
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const char* fileName); // closes the previous file, false if the file can not be mapped
+	void Close(void);
+	bool IsOpen(void) const { return _Data != nullptr; }
+	const uint8_t* GetData(void) const { return _Data; }
+	size_t GetSize(void) const { return _Size; }
+
+private:
+	const uint8_t* _Data = nullptr;
+	size_t _Size = 0;
+#if defined(_WIN32)
+	void* _File = nullptr; // HANDLE
+	void* _Mapping = nullptr;
+#else
+	int _File = -1;
+#endif
+};
+
+#endif
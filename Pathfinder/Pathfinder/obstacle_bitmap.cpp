@@ -0,0 +1,144 @@
+/**
+  ******************************************************************************
+  * @file    obstacle_bitmap.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the obstacle bitmap
+  ******************************************************************************
+  */
+#include "obstacle_bitmap.h"
+
+ObstacleBitmap::ObstacleBitmap(int sizeX, int sizeY)
+{
+	Resize(sizeX, sizeY);
+}
+
+void ObstacleBitmap::Resize(int sizeX, int sizeY)
+{
+	_SizeX = sizeX;
+	_SizeY = sizeY;
+	_RowWords = (sizeX + 63) / 64;
+	_ColumnWords = (sizeY + 63) / 64;
+	_Rows.assign((size_t)_RowWords * sizeY, 0);
+	_Columns.assign((size_t)_ColumnWords * sizeX, 0);
+
+	// unused bits of the last word of every line are marked as blocked, so the
+	// scans stop at the grid edge without an extra check
+	if (sizeX & 63) {
+		uint64_t padding = ~0ull << (sizeX & 63);
+		for (int y = 0; y < sizeY; y++) {
+			_Rows[y * _RowWords + _RowWords - 1] |= padding;
+		}
+	}
+	if (sizeY & 63) {
+		uint64_t padding = ~0ull << (sizeY & 63);
+		for (int x = 0; x < sizeX; x++) {
+			_Columns[x * _ColumnWords + _ColumnWords - 1] |= padding;
+		}
+	}
+}
+
+void ObstacleBitmap::Set(int x, int y, bool blocked)
+{
+	if ((unsigned)x >= (unsigned)_SizeX || (unsigned)y >= (unsigned)_SizeY) return;
+	uint64_t rowBit = 1ull << (x & 63);
+	uint64_t columnBit = 1ull << (y & 63);
+	if (blocked) {
+		_Rows[y * _RowWords + (x >> 6)] |= rowBit;
+		_Columns[x * _ColumnWords + (y >> 6)] |= columnBit;
+	}
+	else {
+		_Rows[y * _RowWords + (x >> 6)] &= ~rowBit;
+		_Columns[x * _ColumnWords + (y >> 6)] &= ~columnBit;
+	}
+}
+
+void ObstacleBitmap::Toggle(int x, int y)
+{
+	if ((unsigned)x >= (unsigned)_SizeX || (unsigned)y >= (unsigned)_SizeY) return;
+	_Rows[y * _RowWords + (x >> 6)] ^= 1ull << (x & 63);
+	_Columns[x * _ColumnWords + (y >> 6)] ^= 1ull << (y & 63);
+}
+
+int ObstacleBitmap::ScanForward(const uint64_t* line, int lineLength, int pos, bool findBlocked)
+{
+	if (pos < 0) pos = 0;
+	if (pos >= lineLength) return lineLength;
+	const uint64_t invert = findBlocked ? 0 : ~0ull;
+	const int wordCount = (lineLength + 63) >> 6;
+	int word = pos >> 6;
+	uint64_t bits = (line[word] ^ invert) & (~0ull << (pos & 63));
+	while (true) {
+		if (bits) {
+			int found = (word << 6) + CountTrailingZeros64(bits);
+			return found < lineLength ? found : lineLength;
+		}
+		if (++word >= wordCount) return lineLength;
+		bits = line[word] ^ invert;
+	}
+}
+
+int ObstacleBitmap::ScanBackward(const uint64_t* line, int lineLength, int pos, bool findBlocked)
+{
+	if (pos >= lineLength) pos = lineLength - 1;
+	if (pos < 0) return -1;
+	const uint64_t invert = findBlocked ? 0 : ~0ull;
+	int word = pos >> 6;
+	uint64_t bits = (line[word] ^ invert) & (~0ull >> (63 - (pos & 63)));
+	while (true) {
+		if (bits) {
+			return (word << 6) + HighestSetBit64(bits);
+		}
+		if (--word < 0) return -1;
+		bits = line[word] ^ invert;
+	}
+}
+
+int ObstacleBitmap::FindNextBlockedInRow(int x, int y) const
+{
+	if ((unsigned)y >= (unsigned)_SizeY) return _SizeX;
+	return ScanForward(&_Rows[y * _RowWords], _SizeX, x, true);
+}
+
+int ObstacleBitmap::FindNextFreeInRow(int x, int y) const
+{
+	if ((unsigned)y >= (unsigned)_SizeY) return _SizeX;
+	return ScanForward(&_Rows[y * _RowWords], _SizeX, x, false);
+}
+
+int ObstacleBitmap::FindPrevBlockedInRow(int x, int y) const
+{
+	if ((unsigned)y >= (unsigned)_SizeY) return -1;
+	return ScanBackward(&_Rows[y * _RowWords], _SizeX, x, true);
+}
+
+int ObstacleBitmap::FindPrevFreeInRow(int x, int y) const
+{
+	if ((unsigned)y >= (unsigned)_SizeY) return -1;
+	return ScanBackward(&_Rows[y * _RowWords], _SizeX, x, false);
+}
+
+int ObstacleBitmap::FindNextBlockedInColumn(int x, int y) const
+{
+	if ((unsigned)x >= (unsigned)_SizeX) return _SizeY;
+	return ScanForward(&_Columns[x * _ColumnWords], _SizeY, y, true);
+}
+
+int ObstacleBitmap::FindNextFreeInColumn(int x, int y) const
+{
+	if ((unsigned)x >= (unsigned)_SizeX) return _SizeY;
+	return ScanForward(&_Columns[x * _ColumnWords], _SizeY, y, false);
+}
+
+int ObstacleBitmap::FindPrevBlockedInColumn(int x, int y) const
+{
+	if ((unsigned)x >= (unsigned)_SizeX) return -1;
+	return ScanBackward(&_Columns[x * _ColumnWords], _SizeY, y, true);
+}
+
+int ObstacleBitmap::FindPrevFreeInColumn(int x, int y) const
+{
+	if ((unsigned)x >= (unsigned)_SizeX) return -1;
+	return ScanBackward(&_Columns[x * _ColumnWords], _SizeY, y, false);
+}
+
@@ -0,0 +1,120 @@
+/**
+  ******************************************************************************
+  * @file    obstacle_bitmap.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the obstacle bitmap. Obstacles
+  *          are stored one bit per cell in 64 bit words, row major. A transposed
+  *          copy is kept as well so that columns can be scanned a word at a time
+  *          just like rows.
+  ******************************************************************************
+  */
+
+#ifndef OBSTACLE_BITMAP_H
+#define OBSTACLE_BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// index of the lowest set bit, value must not be zero
+static inline int CountTrailingZeros64(uint64_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long idx;
+#if defined(_M_X64) || defined(_M_ARM64)
+	_BitScanForward64(&idx, value);
+	return (int)idx;
+#else
+	if ((uint32_t)value != 0) {
+		_BitScanForward(&idx, (uint32_t)value);
+		return (int)idx;
+	}
+	_BitScanForward(&idx, (uint32_t)(value >> 32));
+	return (int)idx + 32;
+#endif
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+// index of the highest set bit, value must not be zero
+static inline int HighestSetBit64(uint64_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long idx;
+#if defined(_M_X64) || defined(_M_ARM64)
+	_BitScanReverse64(&idx, value);
+	return (int)idx;
+#else
+	if ((uint32_t)(value >> 32) != 0) {
+		_BitScanReverse(&idx, (uint32_t)(value >> 32));
+		return (int)idx + 32;
+	}
+	_BitScanReverse(&idx, (uint32_t)value);
+	return (int)idx;
+#endif
+#else
+	return 63 - __builtin_clzll(value);
+#endif
+}
+
+class ObstacleBitmap {
+public:
+	ObstacleBitmap(int sizeX = 0, int sizeY = 0);
+	void Resize(int sizeX, int sizeY); // all cells become free
+	int GetSizeX(void) const { return _SizeX; }
+	int GetSizeY(void) const { return _SizeY; }
+
+	// cells outside of the grid are reported as blocked so the callers do not need bounds checks
+	bool Test(int x, int y) const
+	{
+		if ((unsigned)x >= (unsigned)_SizeX || (unsigned)y >= (unsigned)_SizeY) return true;
+		return (_Rows[y * _RowWords + (x >> 6)] >> (x & 63)) & 1u;
+	}
+	void Set(int x, int y, bool blocked);
+	void Toggle(int x, int y);
+
+	// row scans, next functions return sizeX and previous functions return -1 if nothing is found
+	int FindNextBlockedInRow(int x, int y) const;
+	int FindNextFreeInRow(int x, int y) const;
+	int FindPrevBlockedInRow(int x, int y) const;
+	int FindPrevFreeInRow(int x, int y) const;
+
+	// column scans, next functions return sizeY and previous functions return -1 if nothing is found
+	int FindNextBlockedInColumn(int x, int y) const;
+	int FindNextFreeInColumn(int x, int y) const;
+	int FindPrevBlockedInColumn(int x, int y) const;
+	int FindPrevFreeInColumn(int x, int y) const;
+
+	// raw words for bit parallel algorithms, bits past the grid edge and lines outside of the grid read as blocked
+	int GetRowWordCount(void) const { return _RowWords; }
+	int GetColumnWordCount(void) const { return _ColumnWords; }
+	uint64_t GetRowWord(int y, int word) const
+	{
+		if ((unsigned)y >= (unsigned)_SizeY || (unsigned)word >= (unsigned)_RowWords) return ~0ull;
+		return _Rows[y * _RowWords + word];
+	}
+	uint64_t GetColumnWord(int x, int word) const
+	{
+		if ((unsigned)x >= (unsigned)_SizeX || (unsigned)word >= (unsigned)_ColumnWords) return ~0ull;
+		return _Columns[x * _ColumnWords + word];
+	}
+
+private:
+	int _SizeX = 0;
+	int _SizeY = 0;
+	int _RowWords = 0; // words per row
+	int _ColumnWords = 0; // words per column of the transposed copy
+	std::vector<uint64_t> _Rows; // bit x of row y
+	std::vector<uint64_t> _Columns; // bit y of column x
+
+	static int ScanForward(const uint64_t* line, int lineLength, int pos, bool findBlocked);
+	static int ScanBackward(const uint64_t* line, int lineLength, int pos, bool findBlocked);
+};
+
+#endif
+
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    parallel_for.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains a minimal parallel loop helper for the map
+  *          preprocessing steps. Iterations are handed out one by one from an
+  *          atomic counter, so uneven rows do not stall the other threads.
+  ******************************************************************************
+  */
+
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+// number of worker threads to use when the caller passes 0
+static inline int DefaultThreadCount(void)
+{
+	unsigned int count = std::thread::hardware_concurrency();
+	return count > 0 ? (int)count : 1;
+}
+
+// calls func(i) for every i in [0, count) using threadCount threads (0 means all cores)
+template <typename Func>
+void ParallelFor(int count, int threadCount, Func func)
+{
+	if (threadCount <= 0) threadCount = DefaultThreadCount();
+	threadCount = std::min(threadCount, count);
+	if (threadCount <= 1) {
+		for (int i = 0; i < count; i++) func(i);
+		return;
+	}
+
+	std::atomic<int> next(0);
+	auto worker = [&]() {
+		int i;
+		while ((i = next.fetch_add(1)) < count) func(i);
+	};
+	std::vector<std::thread> threads;
+	for (int t = 1; t < threadCount; t++) {
+		threads.emplace_back(worker);
+	}
+	worker(); // calling thread takes part as well
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+#endif
+
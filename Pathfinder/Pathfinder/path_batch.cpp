@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************
+  * @file    path_batch.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the batch path queries.
+  ******************************************************************************
+  */
+#include "path_batch.h"
+
+PathBatch::PathBatch(const MapGrid& map, MapGrid::Algorithm algorithm, int threadCount)
+	: _Map(map), _Algorithm(algorithm), _Pool(threadCount)
+{
+	_Contexts.resize(_Pool.GetWorkerCount());
+}
+
+int PathBatch::GetThreadCount(void) const
+{
+	return _Pool.GetWorkerCount();
+}
+
+void PathBatch::FindPaths(Span<PathQuery> queries)
+{
+	_Pool.Run(queries.size(), [this, &queries](size_t item, int worker) {
+		PathQuery& query = queries[item];
+		SearchContext<MapGrid::Cost>& context = _Contexts[worker];
+		if (_Map.Search(_Algorithm, query.start, query.target, context)) {
+			_Map.GetPath(context, query.path);
+			query.cost = context.localGoal[context.target];
+		}
+		else {
+			query.path.clear();
+			query.cost = MapGrid::COST_INFINITY;
+		}
+	});
+}
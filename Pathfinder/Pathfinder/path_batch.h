@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    path_batch.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the batch path queries. Many
+  *          start/target pairs are solved against one map on a work stealing
+  *          thread pool, every worker reuses its own search context and the
+  *          paths are written into the caller's query array.
+  ******************************************************************************
+  */
+
+#ifndef PATH_BATCH_H
+#define PATH_BATCH_H
+
+#include <vector>
+#include "map_grid.h"
+#include "span.h"
+#include "thread_pool.h"
+
+struct PathQuery {
+	MapGrid::GridPos start;
+	MapGrid::GridPos target;
+	// results, the path vector keeps its storage between batches
+	std::vector<MapGrid::GridPos> path; // empty if there is no path
+	MapGrid::Cost cost = MapGrid::COST_INFINITY;
+};
+
+class PathBatch {
+public:
+	// the map must outlive the batch and must not be edited while FindPaths runs
+	PathBatch(const MapGrid& map, MapGrid::Algorithm algorithm = MapGrid::Algorithm::JPSPlus, int threadCount = 0);
+	void FindPaths(Span<PathQuery> queries);
+	int GetThreadCount(void) const;
+
+private:
+	const MapGrid& _Map;
+	MapGrid::Algorithm _Algorithm;
+	ThreadPool _Pool;
+	std::vector<SearchContext<MapGrid::Cost>> _Contexts; // one per worker
+};
+
+#endif
@@ -0,0 +1,317 @@
+/**
+  ******************************************************************************
+  * @file    path_database.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the implementation of the compressed path database.
+  ******************************************************************************
+  */
+#include "path_database.h"
+#include "bucket_queue.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+const uint8_t PathDatabase::NO_MOVE;
+const uint32_t PathDatabase::NO_RANK;
+
+static const int SOURCE_BLOCK = 64; // sources per parallel work item, they share the search buffers
+static const uint32_t FILE_MAGIC = 0x31445043u; // "CPD1"
+
+struct PathDatabaseFileHeader {
+	uint32_t magic;
+	uint32_t reserved;
+	int32_t sizeX;
+	int32_t sizeY;
+	uint64_t fingerprint;
+	uint64_t runCount;
+};
+
+// bits of v on the even positions, interleaving x and y gives the Z-order key
+static inline uint32_t SpreadBits(uint32_t v)
+{
+	v &= 0xFFFF;
+	v = (v | (v << 8)) & 0x00FF00FF;
+	v = (v | (v << 4)) & 0x0F0F0F0F;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+	return v;
+}
+
+PathDatabase::PathDatabase(const MapGrid& map) : _Map(map)
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	_SizeX = size.first;
+	_SizeY = size.second;
+}
+
+void PathDatabase::Clear(void)
+{
+	_Ready = false;
+	_Rank = nullptr;
+	_Region = nullptr;
+	_RunBegin = nullptr;
+	_Runs = nullptr;
+	_RunCount = 0;
+	_RankData = std::vector<uint32_t>();
+	_RegionData = std::vector<uint32_t>();
+	_RunBeginData = std::vector<uint64_t>();
+	_RunData = std::vector<uint32_t>();
+	_File.Close();
+}
+
+bool PathDatabase::IsValid(void) const
+{
+	return _Ready && _Map.GetVersion() == _MapVersion;
+}
+
+size_t PathDatabase::GetMemoryBytes(void) const
+{
+	size_t cellCount = (size_t)_SizeX * _SizeY;
+	return _Ready ? cellCount * 2 * sizeof(uint32_t) + (cellCount + 1) * sizeof(uint64_t) + _RunCount * sizeof(uint32_t) : 0;
+}
+
+void PathDatabase::Build(int threadCount)
+{
+	Clear();
+	size_t cellCount = (size_t)_SizeX * _SizeY;
+	std::vector<uint32_t> order; // free cells along the target order
+	BuildOrder(order);
+	BuildRegions();
+
+	int neighbourCount = _Map.GetNeighbourCount();
+	int cellOffset[8];
+	uint32_t stepCost[8];
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		cellOffset[dir] = offset.second * _SizeX + offset.first;
+		stepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	// allowed moves of every cell, one bit per direction code. Every search reads them many times
+	std::vector<uint8_t> moves(cellCount, 0);
+	for (int y = 0; y < _SizeY; y++) {
+		for (int x = 0; x < _SizeX; x++) {
+			for (int dir = 0; dir < neighbourCount; dir++) {
+				MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+				if (_Map.IsMoveAllowed(x, y, offset.first, offset.second)) moves[y * _SizeX + x] |= (uint8_t)(1 << dir);
+			}
+		}
+	}
+
+	std::vector<std::vector<uint32_t>> runs(cellCount);
+	int blockCount = (int)((cellCount + SOURCE_BLOCK - 1) / SOURCE_BLOCK);
+	ParallelFor(blockCount, threadCount, [&](int block) {
+		std::vector<uint32_t> distance(cellCount);
+		std::vector<uint8_t> firstMove(cellCount);
+		BucketQueue<uint32_t> open(cellCount);
+		size_t end = std::min(cellCount, (size_t)(block + 1) * SOURCE_BLOCK);
+		for (uint32_t source = (uint32_t)block * SOURCE_BLOCK; source < end; source++) {
+			if (_RankData[source] == NO_RANK) continue;
+
+			// Dijkstra from the source, every cell inherits the first move of its parent
+			std::fill(distance.begin(), distance.end(), MapGrid::COST_INFINITY);
+			distance[source] = 0;
+			open.Clear();
+			open.PushOrDecrease(source, 0, 0);
+			while (!open.Empty()) {
+				uint32_t current = open.Pop();
+				for (uint32_t bits = moves[current]; bits; bits &= bits - 1) {
+					int dir = CountTrailingZeros64(bits);
+					uint32_t neighbour = current + cellOffset[dir];
+					uint32_t neighbourDistance = distance[current] + stepCost[dir];
+					if (neighbourDistance < distance[neighbour]) {
+						distance[neighbour] = neighbourDistance;
+						firstMove[neighbour] = (current == source) ? (uint8_t)dir : firstMove[current];
+						open.PushOrDecrease(neighbour, neighbourDistance, 0);
+					}
+				}
+			}
+
+			// a new run starts where the move changes, targets that can take any move are skipped.
+			// The first run starts at rank 0, so every rank falls into a run
+			std::vector<uint32_t>& row = runs[source];
+			int move = -1;
+			for (uint32_t rank = 0; rank < order.size(); rank++) {
+				uint32_t target = order[rank];
+				if (target == source || distance[target] == MapGrid::COST_INFINITY || firstMove[target] == move) continue;
+				move = firstMove[target];
+				row.push_back(((row.empty() ? 0 : rank) << 3) | (uint32_t)move);
+			}
+		}
+	});
+
+	_RunBeginData.resize(cellCount + 1);
+	_RunBeginData[0] = 0;
+	for (size_t cell = 0; cell < cellCount; cell++) _RunBeginData[cell + 1] = _RunBeginData[cell] + runs[cell].size();
+	_RunData.resize((size_t)_RunBeginData[cellCount]);
+	for (size_t cell = 0; cell < cellCount; cell++) {
+		std::copy(runs[cell].begin(), runs[cell].end(), _RunData.begin() + (size_t)_RunBeginData[cell]);
+	}
+
+	_Rank = _RankData.data();
+	_Region = _RegionData.data();
+	_RunBegin = _RunBeginData.data();
+	_Runs = _RunData.data();
+	_RunCount = _RunData.size();
+	_MapVersion = _Map.GetVersion();
+	_Ready = true;
+}
+
+// free cells sorted by their Z-order key, the rank of a cell is its position
+void PathDatabase::BuildOrder(std::vector<uint32_t>& order)
+{
+	const ObstacleBitmap& obstacles = _Map.GetObstacleBitmap();
+	std::vector<std::pair<uint32_t, uint32_t>> keys;
+	for (int y = 0; y < _SizeY; y++) {
+		for (int x = 0; x < _SizeX; x++) {
+			if (!obstacles.Test(x, y)) keys.push_back(std::make_pair(SpreadBits(x) | (SpreadBits(y) << 1), (uint32_t)(y * _SizeX + x)));
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+	order.resize(keys.size());
+	_RankData.assign((size_t)_SizeX * _SizeY, NO_RANK);
+	for (size_t rank = 0; rank < keys.size(); rank++) {
+		order[rank] = keys[rank].second;
+		_RankData[keys[rank].second] = (uint32_t)rank;
+	}
+}
+
+// flood fill with the move rules of the map, moves are symmetric
+void PathDatabase::BuildRegions(void)
+{
+	_RegionData.assign((size_t)_SizeX * _SizeY, NO_RANK);
+	std::vector<uint32_t> stack;
+	uint32_t region = 0;
+	for (uint32_t seed = 0; seed < _RegionData.size(); seed++) {
+		if (_RankData[seed] == NO_RANK || _RegionData[seed] != NO_RANK) continue;
+		_RegionData[seed] = region;
+		stack.push_back(seed);
+		while (!stack.empty()) {
+			uint32_t cell = stack.back();
+			stack.pop_back();
+			int x = cell % _SizeX;
+			int y = cell / _SizeX;
+			for (int dir = 0; dir < _Map.GetNeighbourCount(); dir++) {
+				MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+				if (!_Map.IsMoveAllowed(x, y, offset.first, offset.second)) continue;
+				uint32_t neighbour = (y + offset.second) * _SizeX + x + offset.first;
+				if (_RegionData[neighbour] != NO_RANK) continue;
+				_RegionData[neighbour] = region;
+				stack.push_back(neighbour);
+			}
+		}
+		region++;
+	}
+}
+
+int PathDatabase::LookupMove(uint32_t source, uint32_t target) const
+{
+	const uint32_t* first = _Runs + _RunBegin[source];
+	const uint32_t* last = _Runs + _RunBegin[source + 1];
+	if (first == last) return NO_MOVE;
+	// last run that starts at or before the rank of the target
+	const uint32_t* run = std::upper_bound(first, last, (_Rank[target] << 3) | 7u) - 1;
+	return (int)(*run & 7u);
+}
+
+int PathDatabase::GetFirstMove(GridPos sourcePos, GridPos targetPos) const
+{
+	if (!IsValid()) return NO_MOVE;
+	const ObstacleBitmap& obstacles = _Map.GetObstacleBitmap();
+	if (obstacles.Test(sourcePos.first, sourcePos.second) || obstacles.Test(targetPos.first, targetPos.second)) return NO_MOVE;
+	uint32_t source = sourcePos.second * _SizeX + sourcePos.first;
+	uint32_t target = targetPos.second * _SizeX + targetPos.first;
+	if (source == target || _Region[source] != _Region[target]) return NO_MOVE;
+	return LookupMove(source, target);
+}
+
+bool PathDatabase::FindPath(GridPos start, GridPos target, std::vector<GridPos>& path) const
+{
+	path.clear();
+	if (!IsValid() || _Map.GetObstacleBitmap().Test(start.first, start.second)) return false;
+	if (start != target && GetFirstMove(start, target) == NO_MOVE) return false;
+
+	// every move is the first move of a shortest path, so the walk ends at the target. A damaged
+	// table could lead anywhere, the walk stops at moves the map does not allow and at the cell count
+	uint32_t cell = start.second * _SizeX + start.first;
+	uint32_t targetCell = target.second * _SizeX + target.first;
+	size_t stepsLeft = (size_t)_SizeX * _SizeY;
+	path.push_back(start);
+	while (cell != targetCell) {
+		int move = LookupMove(cell, targetCell);
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(move);
+		int x = cell % _SizeX;
+		int y = cell / _SizeX;
+		if (stepsLeft-- == 0 || move >= _Map.GetNeighbourCount() || !_Map.IsMoveAllowed(x, y, offset.first, offset.second)) {
+			path.clear();
+			return false;
+		}
+		cell += offset.second * _SizeX + offset.first;
+		path.push_back(GridPos(cell % _SizeX, cell / _SizeX));
+	}
+	return true;
+}
+
+// a file with the right size and fingerprint can still be damaged, the lookups trust these bounds
+bool PathDatabase::AreTablesValid(void) const
+{
+	size_t cellCount = (size_t)_SizeX * _SizeY;
+	if (_RunBegin[0] != 0 || _RunBegin[cellCount] != _RunCount) return false;
+	for (size_t cell = 0; cell < cellCount; cell++) {
+		if (_Rank[cell] >= cellCount && _Rank[cell] != NO_RANK) return false;
+		if (_RunBegin[cell + 1] < _RunBegin[cell] || _RunBegin[cell + 1] > _RunCount) return false;
+		// the binary search of LookupMove steps back one run, the first run has to start at rank 0
+		if (_RunBegin[cell] != _RunBegin[cell + 1] && (_Runs[_RunBegin[cell]] >> 3) != 0) return false;
+	}
+	return true;
+}
+
+bool PathDatabase::Save(const char* fileName) const
+{
+	if (!_Ready) return false;
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file) return false;
+	size_t cellCount = (size_t)_SizeX * _SizeY;
+	PathDatabaseFileHeader header = { FILE_MAGIC, 0, _SizeX, _SizeY, _Map.GetFingerprint(), (uint64_t)_RunCount };
+	// the header and the sections are multiples of 8 bytes, so every section of the mapping is aligned
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)_Rank, cellCount * sizeof(uint32_t));
+	file.write((const char*)_Region, cellCount * sizeof(uint32_t));
+	file.write((const char*)_RunBegin, (cellCount + 1) * sizeof(uint64_t));
+	file.write((const char*)_Runs, _RunCount * sizeof(uint32_t));
+	return (bool)file;
+}
+
+bool PathDatabase::Load(const char* fileName)
+{
+	Clear();
+	if (!_File.Open(fileName)) return false;
+	size_t cellCount = (size_t)_SizeX * _SizeY;
+	PathDatabaseFileHeader header;
+	bool ok = _File.GetSize() >= sizeof(header);
+	if (ok) {
+		std::memcpy(&header, _File.GetData(), sizeof(header));
+		size_t fileSize = sizeof(header) + cellCount * 2 * sizeof(uint32_t) + (cellCount + 1) * sizeof(uint64_t) + (size_t)header.runCount * sizeof(uint32_t);
+		ok = header.magic == FILE_MAGIC && header.sizeX == _SizeX && header.sizeY == _SizeY &&
+			header.fingerprint == _Map.GetFingerprint() && _File.GetSize() == fileSize;
+	}
+	if (!ok) {
+		_File.Close();
+		return false;
+	}
+
+	const uint8_t* data = _File.GetData() + sizeof(header);
+	_Rank = (const uint32_t*)data;
+	_Region = _Rank + cellCount;
+	_RunBegin = (const uint64_t*)(_Region + cellCount);
+	_Runs = (const uint32_t*)(_RunBegin + cellCount + 1);
+	_RunCount = (size_t)header.runCount;
+	if (!AreTablesValid()) {
+		Clear();
+		return false;
+	}
+	_MapVersion = _Map.GetVersion();
+	_Ready = true;
+	return true;
+}
@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    path_database.h
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the declaration of the compressed path database
+  *          (CPD) for static maps. For every source cell it stores the first
+  *          move of a shortest path to every target, so a query is a chain of
+  *          table lookups without any search. The targets are ordered along a
+  *          Z-order curve, nearby targets mostly share their first move and a
+  *          row of the table compresses into a few runs. A run is stored as the
+  *          rank of its first target and its move, a lookup is a binary search
+  *          in the runs of the source. Targets that can take any move (the
+  *          source itself and other regions) join the runs next to them. The
+  *          table can be saved to a file, loading memory maps the file.
+  ******************************************************************************
+  */
+
+#ifndef PATH_DATABASE_H
+#define PATH_DATABASE_H
+
+#include <vector>
+#include <cstdint>
+#include "map_grid.h"
+#include "mapped_file.h"
+
+class PathDatabase {
+public:
+	typedef MapGrid::GridPos GridPos;
+
+	static const uint8_t NO_MOVE = 0xFF; // source and target are the same or not connected
+
+	// the database keeps a reference to the map, it must outlive the database
+	PathDatabase(const MapGrid& map);
+	// one Dijkstra per free cell, shared between threadCount threads (0 means all cores)
+	void Build(int threadCount = 0);
+	void Clear(void);
+	// the table only answers queries while the map has not changed since the build or load
+	bool IsValid(void) const;
+
+	// binary file tied to the obstacles and move rules of the map. Loading maps the file
+	// into memory, the table is read from the mapping until the next build, load or clear. Files
+	// with sections out of bounds are rejected
+	bool Save(const char* fileName) const;
+	bool Load(const char* fileName);
+
+	// direction code of MapGrid::GetDirectionOffset or NO_MOVE
+	int GetFirstMove(GridPos source, GridPos target) const;
+	// start first, false if there is no path or the table is not valid
+	bool FindPath(GridPos start, GridPos target, std::vector<GridPos>& path) const;
+
+	size_t GetRunCount(void) const { return _RunCount; }
+	size_t GetMemoryBytes(void) const; // size of the table, same as the file without its header
+
+private:
+	static const uint32_t NO_RANK = 0xFFFFFFFFu;
+
+	const MapGrid& _Map;
+	int _SizeX = 0;
+	int _SizeY = 0;
+	uint64_t _MapVersion = 0;
+	bool _Ready = false;
+
+	// table sections, they point into the vectors below after a build or into the mapped file after a load
+	const uint32_t* _Rank = nullptr; // position of every free cell on the target order, NO_RANK for blocked cells
+	const uint32_t* _Region = nullptr; // connected region of every cell, queries between regions have no path
+	const uint64_t* _RunBegin = nullptr; // first run of every cell, one more entry than cells
+	const uint32_t* _Runs = nullptr; // (rank of the first target << 3) | move
+	size_t _RunCount = 0;
+
+	std::vector<uint32_t> _RankData;
+	std::vector<uint32_t> _RegionData;
+	std::vector<uint64_t> _RunBeginData;
+	std::vector<uint32_t> _RunData;
+	MappedFile _File;
+
+	void BuildOrder(std::vector<uint32_t>& order);
+	void BuildRegions(void);
+	int LookupMove(uint32_t source, uint32_t target) const;
+	bool AreTablesValid(void) const; // bounds of the sections, checked before a loaded file is used
+};
+
+#endif
@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file    reverse_tree.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the reverse search tree.
+  ******************************************************************************
+  */
+#include "reverse_tree.h"
+
+ReverseSearchTree::ReverseSearchTree(const MapGrid& map) : _Map(map), _Obstacles(map.GetObstacleBitmap())
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	_SizeX = size.first;
+	_NeighbourCount = map.GetNeighbourCount();
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		_DirX[dir] = offset.first;
+		_DirY[dir] = offset.second;
+		_StepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	_Tree.Prepare(size.first * size.second);
+}
+
+bool ReverseSearchTree::FindPath(GridPos startPos, GridPos targetPos, std::vector<GridPos>& path)
+{
+	path.clear();
+	_ExpandedNodeCount = 0;
+	_PathFound = false;
+	if (_Obstacles.Test(startPos.first, startPos.second) || _Obstacles.Test(targetPos.first, targetPos.second)) return false;
+	uint32_t start = startPos.second * _SizeX + startPos.first;
+	uint32_t target = targetPos.second * _SizeX + targetPos.first;
+	_Start = start;
+
+	if (!_HasTree || target != _Tree.start || _Map.GetVersion() != _MapVersion) StartTree(target, start);
+	if (!_Tree.IsCellVisited(start)) {
+		int expanded = _Tree.expandedNodeCount;
+		Grow(start);
+		_ExpandedNodeCount = _Tree.expandedNodeCount - expanded;
+		if (!_Tree.IsCellVisited(start)) return false;
+	}
+
+	// parent links point towards the target
+	_PathFound = true;
+	for (uint32_t cell = start; cell != SearchContext<Cost>::NO_PARENT; cell = _Tree.parent[cell]) {
+		path.push_back(GridPos(cell % _SizeX, cell / _SizeX));
+	}
+	return true;
+}
+
+MapGrid::Cost ReverseSearchTree::GetPathCost(void) const
+{
+	return _PathFound ? _Tree.localGoal[_Start] : MapGrid::COST_INFINITY;
+}
+
+int ReverseSearchTree::GetExpandedNodeCount(void) const
+{
+	return _ExpandedNodeCount;
+}
+
+int ReverseSearchTree::GetSettledCellCount(void) const
+{
+	return _HasTree ? _Tree.expandedNodeCount : 0;
+}
+
+void ReverseSearchTree::Reset(void)
+{
+	_HasTree = false;
+	_PathFound = false;
+}
+
+void ReverseSearchTree::StartTree(uint32_t root, uint32_t goal)
+{
+	_Tree.BeginSearch((int)_Tree.searchIds.size());
+	_Tree.start = root;
+	_Tree.TouchCell(root);
+	_Tree.localGoal[root] = 0;
+	_Goal = goal;
+	_Tree.OpenCell(root, Heuristic(root, goal));
+	_MapVersion = _Map.GetVersion();
+	_HasTree = true;
+}
+
+void ReverseSearchTree::Grow(uint32_t goal)
+{
+	SearchContext<Cost>& tree = _Tree;
+	if (goal != _Goal) {
+		// open cells keep their costs, only the estimates towards the start change
+		_Goal = goal;
+		tree.openList.Rekey([&tree, goal, this](uint32_t cell) {
+			return tree.localGoal[cell] + Heuristic(cell, goal);
+		});
+	}
+
+	while (!tree.openList.Empty()) {
+		uint32_t current = tree.openList.Pop();
+		tree.MarkVisited(current);
+
+		// moves are symmetric, the reverse search uses the forward move rules
+		int cx = current % _SizeX;
+		int cy = current / _SizeX;
+		for (int dir = 0; dir < _NeighbourCount; dir++) {
+			if (!_Map.IsMoveAllowed(cx, cy, _DirX[dir], _DirY[dir])) continue;
+			uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+			if (tree.IsCellVisited(neighbour)) continue;
+			tree.TouchCell(neighbour);
+			Cost localGoal = tree.localGoal[current] + _StepCost[dir];
+			if (localGoal < tree.localGoal[neighbour]) {
+				tree.parent[neighbour] = current;
+				tree.localGoal[neighbour] = localGoal;
+				tree.OpenCell(neighbour, localGoal + Heuristic(neighbour, goal));
+			}
+		}
+		if (current == goal) break;
+	}
+}
+
+MapGrid::Cost ReverseSearchTree::Heuristic(uint32_t a, uint32_t b) const
+{
+	int dx = (int)(a % _SizeX) - (int)(b % _SizeX);
+	int dy = (int)(a / _SizeX) - (int)(b / _SizeX);
+	if (_NeighbourCount == 4) return ManhattanCost<Cost>(dx, dy);
+	return OctileCost<Cost>(dx, dy);
+}
@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file    reverse_tree.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the reverse search tree. An A*
+  *          search runs from the target towards the start and is kept between
+  *          queries. Expanded cells have their exact cost to the target for any
+  *          consistent heuristic, so a start inside the expanded region is
+  *          answered by walking the parent links. A start outside of it re-keys
+  *          the open list towards the new start and continues the search. The
+  *          tree starts over when the target or the map version changes.
+  ******************************************************************************
+  */
+
+#ifndef REVERSE_TREE_H
+#define REVERSE_TREE_H
+
+#include <vector>
+#include <cstdint>
+#include "map_grid.h"
+#include "search_context.h"
+
+class ReverseSearchTree {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::Cost Cost;
+
+	// the tree keeps a reference to the map, it must outlive the tree
+	ReverseSearchTree(const MapGrid& map);
+	// path from start to target, start first, reuses the vector's storage. True if a path is found
+	bool FindPath(GridPos start, GridPos target, std::vector<GridPos>& path);
+	Cost GetPathCost(void) const; // cost of the last path or COST_INFINITY
+	int GetExpandedNodeCount(void) const; // nodes expanded by the last query, 0 if the tree already had the start
+	int GetSettledCellCount(void) const; // cells with an exact cost to the target
+	void Reset(void); // the next query starts a new tree
+
+private:
+	const MapGrid& _Map;
+	const ObstacleBitmap& _Obstacles;
+	int _SizeX = 0;
+	int _DirX[8];
+	int _DirY[8];
+	Cost _StepCost[8];
+	int _NeighbourCount = 4;
+
+	SearchContext<Cost> _Tree; // start of the context is the target of the queries, the root of the tree
+	bool _HasTree = false;
+	uint32_t _Goal = 0; // start the open list keys are aimed at
+	uint64_t _MapVersion = 0;
+	uint32_t _Start = 0;
+	bool _PathFound = false;
+	int _ExpandedNodeCount = 0;
+
+	void StartTree(uint32_t root, uint32_t goal);
+	void Grow(uint32_t goal);
+	Cost Heuristic(uint32_t a, uint32_t b) const;
+};
+
+#endif
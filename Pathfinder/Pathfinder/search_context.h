@@ -0,0 +1,128 @@
+/**
+  ******************************************************************************
+  * @file    search_context.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the per search data of the grid searches. The
+  *          arrays are reused between searches, a new search id makes the old
+  *          entries stale and cells are reset when a search touches them.
+  ******************************************************************************
+  */
+
+#ifndef SEARCH_CONTEXT_H
+#define SEARCH_CONTEXT_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "indexed_heap.h"
+#include "bucket_queue.h"
+#include "cost_traits.h"
+
+// the open list is an IndexedHeap by default, integer costs can use a BucketQueue instead
+template <typename CostT, typename OpenListT = IndexedHeap<CostT>>
+struct SearchContext {
+public:
+	static const uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+	// one entry per cell, f values only live in the open list keys
+	std::vector<CostT> localGoal; // cost from start (g)
+	std::vector<uint32_t> parent; // cell index of the parent or NO_PARENT
+	std::vector<unsigned int> searchIds; // search that last touched the cell, older values mean stale data
+	std::vector<unsigned int> visitedIds; // search that expanded the cell
+	OpenListT openList; // cells to be tested, keyed by global goal
+	unsigned int searchId = 0; // incremented at the beginning of every search
+	int expandedNodeCount = 0; // number of nodes expanded by the last search
+	uint32_t start = 0; // start cell of the last search
+	uint32_t target = 0; // target cell of the last search, reached if it is visited
+	std::vector<uint32_t> pathCells; // storage of MapGrid::GetPathCells, keeps its capacity between searches
+
+	// allocates the arrays for the grid, does nothing if they already fit
+	void Prepare(int cellCount)
+	{
+		if ((int)searchIds.size() == cellCount) return;
+		localGoal.assign(cellCount, CostTraits<CostT>::Infinity());
+		parent.assign(cellCount, NO_PARENT);
+		searchIds.assign(cellCount, 0);
+		visitedIds.assign(cellCount, 0);
+		openList.Resize(cellCount);
+		searchId = 0;
+	}
+
+	void BeginSearch(int cellCount)
+	{
+		Prepare(cellCount);
+		openList.Clear();
+		expandedNodeCount = 0;
+		// a new search id invalidates the data of every cell at once
+		searchId++;
+		if (searchId == 0) {
+			// counter wrapped around, old ids could be mistaken for the current one
+			std::fill(searchIds.begin(), searchIds.end(), 0);
+			std::fill(visitedIds.begin(), visitedIds.end(), 0);
+			searchId = 1;
+		}
+	}
+
+	void TouchCell(uint32_t idx)
+	{
+		if (searchIds[idx] != searchId) {
+			searchIds[idx] = searchId;
+			parent[idx] = NO_PARENT;
+			localGoal[idx] = CostTraits<CostT>::Infinity();
+		}
+	}
+
+	bool IsCellVisited(uint32_t idx) const
+	{
+		// visited ids left by older searches are stale
+		return searchId != 0 && visitedIds[idx] == searchId;
+	}
+
+	void MarkVisited(uint32_t idx)
+	{
+		visitedIds[idx] = searchId;
+		expandedNodeCount++;
+	}
+
+	// adds the cell to the open list or lowers its key, localGoal of the cell must be up to date
+	void OpenCell(uint32_t idx, CostT globalGoal)
+	{
+		PushOpen(openList, idx, globalGoal);
+	}
+
+	CostT GetCost(uint32_t idx) const
+	{
+		return (searchId != 0 && searchIds[idx] == searchId) ? localGoal[idx] : CostTraits<CostT>::Infinity();
+	}
+
+private:
+	void PushOpen(IndexedHeap<CostT>& list, uint32_t idx, CostT globalGoal)
+	{
+		list.PushOrDecrease(idx, globalGoal);
+	}
+
+	void PushOpen(BucketQueue<CostT>& list, uint32_t idx, CostT globalGoal)
+	{
+		// equal global goals are broken towards the cell closer to the target
+		list.PushOrDecrease(idx, globalGoal, localGoal[idx]);
+	}
+};
+
+template <typename CostT, typename OpenListT>
+const uint32_t SearchContext<CostT, OpenListT>::NO_PARENT;
+
+// search data with the bucket queue open list, integer costs only
+template <typename CostT>
+using BucketSearchContext = SearchContext<CostT, BucketQueue<CostT>>;
+
+// calls MACRO for every context type the map searches are instantiated for
+#define FOR_EACH_SEARCH_CONTEXT(MACRO) \
+	MACRO(SearchContext<uint32_t>) \
+	MACRO(SearchContext<uint64_t>) \
+	MACRO(SearchContext<float>) \
+	MACRO(SearchContext<double>) \
+	MACRO(BucketSearchContext<uint32_t>) \
+	MACRO(BucketSearchContext<uint64_t>)
+
+#endif
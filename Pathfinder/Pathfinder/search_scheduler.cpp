@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    search_scheduler.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the implementation of the time sliced search
+  *          scheduler.
+  ******************************************************************************
+  */
+#include "search_scheduler.h"
+#include <algorithm>
+
+const int SearchScheduler::NO_TICKET;
+
+SearchScheduler::SearchScheduler(const MapGrid& map, int expansionsPerSlice)
+	: _Map(map), _ExpansionsPerSlice(std::max(expansionsPerSlice, 1))
+{
+}
+
+int SearchScheduler::Submit(GridPos start, GridPos target)
+{
+	size_t ticket = 0;
+	while (ticket < _Slots.size() && _Slots[ticket]->inUse) ticket++;
+	if (ticket == _Slots.size()) _Slots.emplace_back(new Slot());
+	Slot& slot = *_Slots[ticket];
+	slot.inUse = true;
+	slot.start = start;
+	slot.target = target;
+	slot.status = SearchStatus::NoPath;
+	Start(slot);
+	return (int)ticket;
+}
+
+void SearchScheduler::Release(int ticket)
+{
+	if (ticket < 0 || ticket >= (int)_Slots.size() || !_Slots[ticket]->inUse) return;
+	Slot& slot = *_Slots[ticket];
+	SetStatus(slot, SearchStatus::NoPath);
+	slot.inUse = false;
+}
+
+int SearchScheduler::RunFrame(std::chrono::microseconds budget)
+{
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point deadline = Clock::now() + budget;
+	int expanded = 0;
+	while (_RunningCount > 0) {
+		// next running slot in turn order
+		while (_NextSlot >= _Slots.size() || _Slots[_NextSlot]->status != SearchStatus::Running) {
+			_NextSlot = (_NextSlot + 1 < _Slots.size()) ? _NextSlot + 1 : 0;
+		}
+		Slot& slot = *_Slots[_NextSlot];
+		_NextSlot++;
+		// the context was built on an older map, its costs and parents may not hold anymore
+		if (slot.mapVersion != _Map.GetVersion()) Start(slot);
+		if (slot.status == SearchStatus::Running) {
+			int before = slot.context.expandedNodeCount;
+			SetStatus(slot, _Map.StepSlicedSearch(slot.context, _ExpansionsPerSlice));
+			expanded += slot.context.expandedNodeCount - before;
+		}
+		if (Clock::now() >= deadline) break;
+	}
+	return expanded;
+}
+
+MapGrid::SearchStatus SearchScheduler::GetStatus(int ticket) const
+{
+	if (ticket < 0 || ticket >= (int)_Slots.size() || !_Slots[ticket]->inUse) return SearchStatus::NoPath;
+	return _Slots[ticket]->status;
+}
+
+bool SearchScheduler::GetPath(int ticket, std::vector<GridPos>& path) const
+{
+	path.clear();
+	if (GetStatus(ticket) != SearchStatus::Found) return false;
+	_Map.GetPath(_Slots[ticket]->context, path);
+	return true;
+}
+
+const SearchContext<MapGrid::Cost>& SearchScheduler::GetContext(int ticket) const
+{
+	return _Slots[ticket]->context;
+}
+
+void SearchScheduler::Start(Slot& slot)
+{
+	slot.mapVersion = _Map.GetVersion();
+	SetStatus(slot, _Map.BeginSlicedSearch(slot.start, slot.target, slot.context));
+}
+
+void SearchScheduler::SetStatus(Slot& slot, SearchStatus status)
+{
+	// the running count follows every change so RunFrame never scans for running slots in vain
+	if (slot.status == SearchStatus::Running) _RunningCount--;
+	if (status == SearchStatus::Running) _RunningCount++;
+	slot.status = status;
+}
@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file    search_scheduler.h
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the declaration of the time sliced search
+  *          scheduler. Searches are submitted at any time and advanced by
+  *          RunFrame, which steps the running ones in turn, a slice of
+  *          expansions each, until the frame budget is used up. The turn order
+  *          carries over to the next frame so every search makes progress. A
+  *          running search whose map changed since it started starts over.
+  ******************************************************************************
+  */
+
+#ifndef SEARCH_SCHEDULER_H
+#define SEARCH_SCHEDULER_H
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "map_grid.h"
+
+class SearchScheduler {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::SearchStatus SearchStatus;
+
+	static const int NO_TICKET = -1;
+
+	// the scheduler keeps a reference to the map, it must outlive the scheduler
+	SearchScheduler(const MapGrid& map, int expansionsPerSlice = 256);
+	// ticket of the new search, valid until it is released
+	int Submit(GridPos start, GridPos target);
+	// the search stops and its context is kept for the next submit
+	void Release(int ticket);
+	// steps the running searches until the budget is used up or none is left running. The clock is
+	// read after every slice, so a frame can run over by one slice. Returns the expanded cell count
+	int RunFrame(std::chrono::microseconds budget);
+
+	SearchStatus GetStatus(int ticket) const;
+	bool GetPath(int ticket, std::vector<GridPos>& path) const; // false unless the search found a path
+	// search data of the ticket, e.g. to draw the visited cells
+	const SearchContext<MapGrid::Cost>& GetContext(int ticket) const;
+	int GetRunningCount(void) const { return _RunningCount; }
+
+private:
+	// every search owns a grid sized context, released searches are reused by the next submit
+	struct Slot {
+		SearchContext<MapGrid::Cost> context;
+		GridPos start;
+		GridPos target;
+		uint64_t mapVersion = 0;
+		SearchStatus status = SearchStatus::NoPath;
+		bool inUse = false;
+	};
+
+	const MapGrid& _Map;
+	int _ExpansionsPerSlice = 256;
+	std::vector<std::unique_ptr<Slot>> _Slots; // index is the ticket
+	size_t _NextSlot = 0; // first slot of the next turn
+	int _RunningCount = 0;
+
+	void Start(Slot& slot);
+	void SetStatus(Slot& slot, SearchStatus status);
+};
+
+#endif
@@ -0,0 +1,41 @@
+/**
+  ******************************************************************************
+  * @file    span.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains a minimal non owning view over contiguous memory,
+  *          used by the APIs that read from or write into caller owned buffers.
+  ******************************************************************************
+  */
+
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+template <typename T>
+class Span {
+public:
+	Span() {}
+	Span(T* data, size_t size) : _Data(data), _Size(size) {}
+	template <typename Allocator>
+	Span(std::vector<T, Allocator>& vector) : _Data(vector.data()), _Size(vector.size()) {}
+	// read only view of a vector, only compiles for Span<const T>
+	template <typename Allocator>
+	Span(const std::vector<typename std::remove_const<T>::type, Allocator>& vector) : _Data(vector.data()), _Size(vector.size()) {}
+
+	T* data() const { return _Data; }
+	size_t size() const { return _Size; }
+	bool empty() const { return _Size == 0; }
+	T& operator[](size_t idx) const { return _Data[idx]; }
+	T* begin() const { return _Data; }
+	T* end() const { return _Data + _Size; }
+
+private:
+	T* _Data = nullptr;
+	size_t _Size = 0;
+};
+
+#endif
@@ -0,0 +1,210 @@
+/**
+  ******************************************************************************
+  * @file    theta_star.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the implementation of the Lazy Theta* search.
+  ******************************************************************************
+  */
+#include "theta_star.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// true if cells [from, to] of a line have no obstacle, lineWord(word) reads the bitmap a word at a time
+template <typename WordFunc>
+static bool IsSpanFree(WordFunc lineWord, int from, int to)
+{
+	int first = from >> 6;
+	int last = to >> 6;
+	for (int word = first; word <= last; word++) {
+		uint64_t bits = lineWord(word);
+		if (word == first) bits &= ~0ull << (from & 63);
+		if (word == last) bits &= ~0ull >> (63 - (to & 63));
+		if (bits) return false;
+	}
+	return true;
+}
+
+/**
+  * @brief  Bresenham style walk over the lines (rows or columns) of the bitmap. The line
+  *         from the center of (p0, q0) to the center of (p1, q1) crosses line q over a span
+  *         of cells, the span is tested a word at a time. Coordinates are in half cells, so
+  *         cell centers and cell edges are both integers and the spans are exact.
+  */
+template <typename WordFunc>
+static bool IsLineFree(WordFunc word, int p0, int q0, int p1, int q1)
+{
+	if (q0 > q1) {
+		std::swap(p0, p1);
+		std::swap(q0, q1);
+	}
+	if (q0 == q1) return IsSpanFree([&](int w) { return word(q0, w); }, std::min(p0, p1), std::max(p0, p1));
+
+	const int64_t P0 = 2 * p0 + 1;
+	const int64_t Q0 = 2 * q0 + 1;
+	const int64_t dP = 2 * (int64_t)(p1 - p0);
+	const int64_t dQ = 2 * (int64_t)(q1 - q0);
+	for (int q = q0; q <= q1; q++) {
+		// part of the segment inside line q, positions along p are numerators over dQ
+		int64_t enter = std::max<int64_t>(2 * q, Q0) - Q0;
+		int64_t leave = std::min<int64_t>(2 * q + 2, Q0 + dQ) - Q0;
+		int64_t a = P0 * dQ + enter * dP;
+		int64_t b = P0 * dQ + leave * dP;
+		int64_t low = std::min(a, b);
+		int64_t high = std::max(a, b);
+		// cell p spans [2p, 2p + 2], it is touched if the span overlaps [low, high] / dQ, edges included
+		int from = (int)((low + 2 * dQ - 1) / (2 * dQ)) - 1;
+		int to = (int)(high / (2 * dQ));
+		if (!IsSpanFree([&](int w) { return word(q, w); }, std::max(from, 0), to)) return false;
+	}
+	return true;
+}
+
+LazyThetaStar::LazyThetaStar(const MapGrid& map) : _Map(map), _Obstacles(map.GetObstacleBitmap())
+{
+	MapGrid::GridSize size = map.GetGridSize();
+	_SizeX = size.first;
+	_NeighbourCount = map.GetNeighbourCount();
+	for (int dir = 0; dir < 8; dir++) {
+		MapGrid::GridPos offset = MapGrid::GetDirectionOffset(dir);
+		_DirX[dir] = offset.first;
+		_DirY[dir] = offset.second;
+		_StepCost[dir] = (dir < 4) ? MapGrid::COST_STRAIGHT : MapGrid::COST_DIAGONAL;
+	}
+	_Search.Prepare(size.first * size.second);
+}
+
+bool LazyThetaStar::FindPath(GridPos startPos, GridPos targetPos, std::vector<GridPos>& waypoints)
+{
+	waypoints.clear();
+	_PathFound = false;
+	_LineOfSightChecks = 0;
+	SearchContext<Cost>& search = _Search;
+	search.BeginSearch((int)search.searchIds.size());
+	if (_Obstacles.Test(startPos.first, startPos.second) || _Obstacles.Test(targetPos.first, targetPos.second)) return false;
+	if (!_Map.AreConnected(startPos, targetPos)) return false;
+	uint32_t start = startPos.second * _SizeX + startPos.first;
+	uint32_t target = targetPos.second * _SizeX + targetPos.first;
+	search.start = start;
+	search.target = target;
+
+	// the start is its own parent, every other cell gets the parent of the cell that reached it
+	search.TouchCell(start);
+	search.localGoal[start] = 0;
+	search.parent[start] = start;
+	search.OpenCell(start, Heuristic(start, target));
+	while (!search.openList.Empty()) {
+		uint32_t current = search.openList.Pop();
+		SetVertex(current);
+		search.MarkVisited(current);
+		if (current == target) break;
+
+		int cx = current % _SizeX;
+		int cy = current / _SizeX;
+		uint32_t parent = search.parent[current];
+		for (int dir = 0; dir < _NeighbourCount; dir++) {
+			if (!_Map.IsMoveAllowed(cx, cy, _DirX[dir], _DirY[dir])) continue;
+			uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+			if (search.IsCellVisited(neighbour)) continue;
+			search.TouchCell(neighbour);
+			// the line from the parent is assumed free, SetVertex checks it on expansion
+			Cost localGoal = search.localGoal[parent] + Distance(parent, neighbour);
+			if (localGoal < search.localGoal[neighbour]) {
+				search.parent[neighbour] = parent;
+				search.localGoal[neighbour] = localGoal;
+				search.OpenCell(neighbour, localGoal + Heuristic(neighbour, target));
+			}
+		}
+	}
+	if (!search.IsCellVisited(target)) return false;
+
+	_PathFound = true;
+	for (uint32_t cell = target;; cell = search.parent[cell]) {
+		waypoints.push_back(GridPos(cell % _SizeX, cell / _SizeX));
+		if (cell == start) break;
+	}
+	std::reverse(waypoints.begin(), waypoints.end());
+	return true;
+}
+
+MapGrid::Cost LazyThetaStar::GetPathCost(void) const
+{
+	return _PathFound ? _Search.localGoal[_Search.target] : MapGrid::COST_INFINITY;
+}
+
+int LazyThetaStar::GetExpandedNodeCount(void) const
+{
+	return _Search.expandedNodeCount;
+}
+
+int LazyThetaStar::GetLineOfSightCheckCount(void) const
+{
+	return _LineOfSightChecks;
+}
+
+bool LazyThetaStar::HasLineOfSight(GridPos a, GridPos b) const
+{
+	if (_Obstacles.Test(a.first, a.second) || _Obstacles.Test(b.first, b.second)) return false;
+	return HasLineOfSight((uint32_t)(a.second * _SizeX + a.first), (uint32_t)(b.second * _SizeX + b.first));
+}
+
+bool LazyThetaStar::HasLineOfSight(uint32_t a, uint32_t b) const
+{
+	int ax = a % _SizeX;
+	int ay = a / _SizeX;
+	int bx = b % _SizeX;
+	int by = b / _SizeX;
+	// flat lines cross few rows with long spans, steep ones are walked on the transposed columns
+	if (std::abs(bx - ax) >= std::abs(by - ay)) {
+		return IsLineFree([this](int row, int word) { return _Obstacles.GetRowWord(row, word); }, ax, ay, bx, by);
+	}
+	return IsLineFree([this](int column, int word) { return _Obstacles.GetColumnWord(column, word); }, ay, ax, by, bx);
+}
+
+void LazyThetaStar::SetVertex(uint32_t cell)
+{
+	SearchContext<Cost>& search = _Search;
+	uint32_t parent = search.parent[cell];
+	if (parent == cell) return; // start
+	int dx = (int)(cell % _SizeX) - (int)(parent % _SizeX);
+	int dy = (int)(cell / _SizeX) - (int)(parent / _SizeX);
+	// a neighbouring parent is one grid move, the move rules of the map decide
+	if (std::abs(dx) <= 1 && std::abs(dy) <= 1) {
+		if (_Map.IsMoveAllowed(parent % _SizeX, parent / _SizeX, dx, dy)) return;
+	}
+	else {
+		_LineOfSightChecks++;
+		if (HasLineOfSight(parent, cell)) return;
+	}
+
+	// the line is blocked, the cheapest expanded grid neighbour becomes the parent. The cell
+	// was reached from one of them, so there is always one
+	int cx = cell % _SizeX;
+	int cy = cell / _SizeX;
+	search.localGoal[cell] = MapGrid::COST_INFINITY;
+	for (int dir = 0; dir < _NeighbourCount; dir++) {
+		if (!_Map.IsMoveAllowed(cx, cy, _DirX[dir], _DirY[dir])) continue;
+		uint32_t neighbour = (cy + _DirY[dir]) * _SizeX + cx + _DirX[dir];
+		if (!search.IsCellVisited(neighbour)) continue;
+		Cost localGoal = search.localGoal[neighbour] + _StepCost[dir];
+		if (localGoal < search.localGoal[cell]) {
+			search.localGoal[cell] = localGoal;
+			search.parent[cell] = neighbour;
+		}
+	}
+}
+
+MapGrid::Cost LazyThetaStar::Distance(uint32_t a, uint32_t b) const
+{
+	double dx = (double)((int)(a % _SizeX) - (int)(b % _SizeX));
+	double dy = (double)((int)(a / _SizeX) - (int)(b / _SizeX));
+	return (Cost)std::lround(std::sqrt(dx * dx + dy * dy) * MapGrid::COST_STRAIGHT);
+}
+
+MapGrid::Cost LazyThetaStar::Heuristic(uint32_t a, uint32_t b) const
+{
+	double dx = (double)((int)(a % _SizeX) - (int)(b % _SizeX));
+	double dy = (double)((int)(a / _SizeX) - (int)(b / _SizeX));
+	return (Cost)(std::sqrt(dx * dx + dy * dy) * MapGrid::COST_STRAIGHT);
+}
@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    theta_star.h
+  * @author  Ali Batuhan KINDAN
+  * @date    18.10.2026
+  * @brief   This file contains the declaration of the Lazy Theta* any-angle
+  *          search. Like A* it expands grid neighbours, but a neighbour takes
+  *          the parent of the expanded cell as its own parent, so paths run
+  *          along straight lines at any angle. The line of sight behind that
+  *          shortcut is only checked once the cell is expanded, a blocked line
+  *          falls back to the best expanded grid neighbour. The path is a short
+  *          list of waypoints, the lines between them are free.
+  ******************************************************************************
+  */
+
+#ifndef THETA_STAR_H
+#define THETA_STAR_H
+
+#include <vector>
+#include <cstdint>
+#include "map_grid.h"
+#include "search_context.h"
+
+class LazyThetaStar {
+public:
+	typedef MapGrid::GridPos GridPos;
+	typedef MapGrid::Cost Cost;
+
+	// the search keeps a reference to the map, it must outlive the search
+	LazyThetaStar(const MapGrid& map);
+	// waypoints from start to target, start first, reuses the vector's storage. True if a path is found
+	bool FindPath(GridPos start, GridPos target, std::vector<GridPos>& waypoints);
+	Cost GetPathCost(void) const; // euclidean length of the last path, COST_STRAIGHT per cell, or COST_INFINITY
+	int GetExpandedNodeCount(void) const;
+	int GetLineOfSightCheckCount(void) const; // checks of the last search
+
+	// true if the line between the cell centers only touches free cells. Touching counts
+	// corners, so a line through the corner of a blocked cell is blocked, the same as
+	// diagonal moves without corner cutting
+	bool HasLineOfSight(GridPos a, GridPos b) const;
+
+private:
+	const MapGrid& _Map;
+	const ObstacleBitmap& _Obstacles;
+	int _SizeX = 0;
+	int _DirX[8];
+	int _DirY[8];
+	Cost _StepCost[8];
+	int _NeighbourCount = 4;
+
+	SearchContext<Cost> _Search;
+	bool _PathFound = false;
+	int _LineOfSightChecks = 0;
+
+	bool HasLineOfSight(uint32_t a, uint32_t b) const;
+	void SetVertex(uint32_t cell);
+	Cost Distance(uint32_t a, uint32_t b) const; // euclidean, rounded to the nearest cost unit
+	Cost Heuristic(uint32_t a, uint32_t b) const; // euclidean, rounded down
+};
+
+#endif
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    thread_pool.cpp
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the implementation of the work stealing thread pool.
+  ******************************************************************************
+  */
+#include "thread_pool.h"
+#include "parallel_for.h"
+#include <algorithm>
+
+static const size_t CHUNKS_PER_WORKER = 8; // small enough to balance, large enough to keep the locks cold
+
+ThreadPool::ThreadPool(int threadCount)
+{
+	if (threadCount <= 0) threadCount = DefaultThreadCount();
+	for (int i = 0; i < threadCount; i++) {
+		_Workers.emplace_back(new Worker());
+	}
+	for (int i = 1; i < threadCount; i++) {
+		_Threads.emplace_back(&ThreadPool::ThreadLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(_JobLock);
+		_Stop = true;
+	}
+	_JobStart.notify_all();
+	for (std::thread& thread : _Threads) {
+		thread.join();
+	}
+}
+
+void ThreadPool::Run(size_t count, const std::function<void(size_t item, int worker)>& func)
+{
+	if (count == 0) return;
+
+	// contiguous chunks, every worker gets a neighbouring block of them
+	size_t workerCount = _Workers.size();
+	size_t chunkCount = std::min(count, workerCount * CHUNKS_PER_WORKER);
+	for (size_t i = 0; i < chunkCount; i++) {
+		Chunk chunk = { count * i / chunkCount, count * (i + 1) / chunkCount };
+		Worker& worker = *_Workers[i * workerCount / chunkCount];
+		std::lock_guard<std::mutex> guard(worker.lock);
+		worker.chunks.push_back(chunk);
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(_JobLock);
+		_Job = &func;
+		_BusyThreads = (int)_Threads.size();
+		_JobId++;
+	}
+	_JobStart.notify_all();
+
+	WorkOn(0, func);
+
+	// func must outlive every call, so wait for the other threads to leave the job
+	std::unique_lock<std::mutex> guard(_JobLock);
+	_JobDone.wait(guard, [this]() { return _BusyThreads == 0; });
+	_Job = nullptr;
+}
+
+void ThreadPool::ThreadLoop(int worker)
+{
+	unsigned int lastJob = 0;
+	while (true) {
+		const std::function<void(size_t, int)>* job;
+		{
+			std::unique_lock<std::mutex> guard(_JobLock);
+			_JobStart.wait(guard, [&]() { return _Stop || _JobId != lastJob; });
+			if (_Stop) return;
+			lastJob = _JobId;
+			job = _Job;
+		}
+
+		WorkOn(worker, *job);
+
+		std::lock_guard<std::mutex> guard(_JobLock);
+		if (--_BusyThreads == 0) _JobDone.notify_one();
+	}
+}
+
+void ThreadPool::WorkOn(int worker, const std::function<void(size_t, int)>& func)
+{
+	Chunk chunk;
+	while (TakeChunk(worker, chunk)) {
+		for (size_t item = chunk.begin; item < chunk.end; item++) func(item, worker);
+	}
+}
+
+bool ThreadPool::TakeChunk(int worker, Chunk& chunk)
+{
+	// own chunks first, newest first
+	{
+		Worker& own = *_Workers[worker];
+		std::lock_guard<std::mutex> guard(own.lock);
+		if (!own.chunks.empty()) {
+			chunk = own.chunks.back();
+			own.chunks.pop_back();
+			return true;
+		}
+	}
+
+	// steal the oldest chunk of the next worker that still has work. Chunks are only added
+	// before the job starts, so the job is finished once every queue is seen empty
+	int workerCount = (int)_Workers.size();
+	for (int i = 1; i < workerCount; i++) {
+		Worker& victim = *_Workers[(worker + i) % workerCount];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if (!victim.chunks.empty()) {
+			chunk = victim.chunks.front();
+			victim.chunks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
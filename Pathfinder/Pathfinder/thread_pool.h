@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    thread_pool.h
+  * @author  Ali Batuhan KINDAN
+  * @date    17.10.2026
+  * @brief   This file contains the declaration of the work stealing thread pool.
+  *          A job is a range of items cut into chunks. Every worker starts with
+  *          its own share of the chunks and takes them from the back of its
+  *          queue, a worker that runs out steals from the front of the others,
+  *          so a few long items do not leave the other threads waiting.
+  ******************************************************************************
+  */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+	// threadCount workers (0 means all cores), the thread calling Run is one of them
+	explicit ThreadPool(int threadCount = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int GetWorkerCount(void) const { return (int)_Workers.size(); }
+	// calls func(item, worker) for every item in [0, count) and returns when all of them are done.
+	// worker is in [0, GetWorkerCount()), calls with the same worker never run at the same time
+	void Run(size_t count, const std::function<void(size_t item, int worker)>& func);
+
+private:
+	struct Chunk {
+		size_t begin;
+		size_t end;
+	};
+
+	struct Worker {
+		std::mutex lock;
+		std::deque<Chunk> chunks;
+	};
+
+	std::vector<std::unique_ptr<Worker>> _Workers;
+	std::vector<std::thread> _Threads; // worker 0 is the calling thread, so one less than the workers
+	std::mutex _JobLock;
+	std::condition_variable _JobStart;
+	std::condition_variable _JobDone;
+	const std::function<void(size_t, int)>* _Job = nullptr;
+	unsigned int _JobId = 0; // incremented for every job, wakes the threads up
+	int _BusyThreads = 0; // threads still working on the current job
+	bool _Stop = false;
+
+	void ThreadLoop(int worker);
+	void WorkOn(int worker, const std::function<void(size_t, int)>& func);
+	bool TakeChunk(int worker, Chunk& chunk);
+};
+
+#endif